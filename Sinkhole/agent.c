@@ -0,0 +1,379 @@
+//------------------------------------------------------------------------------------
+// file: agent.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Agent API for Automated Playtesting
+//		Changed entities to be observed from the slots in use of their Pool
+//		Changed observing to pick the nearest from one distance array per kind, so it can be done every step
+//
+// brief:
+// Turns the world into observations and actions into input, for bots that
+// only see the array of floats. Everything is on the stack, nothing is
+// allocated. The distances of every entity alive of one kind are put in one
+// array (walking enemies a group of lanes at a time, with SIMD) and the
+// nearest few are picked from it with selects instead of branches. Nothing
+// is divided, values are scaled by multiplying. Each action is played for
+// AGENT_ACTION_REPEAT (1) step by default, the headless runner's -bot agent
+// prints what observing adds on top of the steps.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#include <math.h>
+#include <string.h>
+#ifdef _MSC_VER
+#include <intrin.h> // For _BitScanForward64
+#endif
+#include "initialize.h"
+#include "sim.h"
+#include "platforms.h"
+#include "agent.h"
+
+#if defined(__AVX__)
+#define AGENT_LANES 8 // Walking enemy distances worked out by one instruction
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AGENT_LANES 4
+#include <emmintrin.h>
+#else
+#define AGENT_LANES 4
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AGENT_SSE 1 // Platform edges, one SSE register each
+#endif
+
+#pragma region observe
+
+#define AGENT_PER_WIDTH (1.0f / WINDOW_WIDTH) // Multiplied by instead of dividing by the window size
+#define AGENT_PER_HEIGHT (1.0f / WINDOW_HEIGHT)
+
+// Index of the lowest bit set
+static int Agent_FirstBit(unsigned long long bits) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return (int)index;
+#else
+	return __builtin_ctzll(bits);
+#endif
+}
+
+// Moves the n smallest of count distances (and their indices) to the front, closest first, by taking
+// the smallest of the rest n times. The smallest is found with selects instead of branches, so it costs
+// the same however the distances are ordered. Not needed for one or none, which is most of the time
+static void Agent_SortNearest(float distances[], int indices[], int count, int n) {
+	for (int j = 0; j < n; ++j) {
+		int smallest = j;
+		float smallestDistance = distances[j];
+		for (int k = j + 1; k < count; ++k) {
+			int isCloser = distances[k] < smallestDistance;
+			smallest = isCloser ? k : smallest;
+			smallestDistance = isCloser ? distances[k] : smallestDistance;
+		}
+		int index = indices[smallest];
+		distances[smallest] = distances[j];
+		indices[smallest] = indices[j];
+		distances[j] = smallestDistance;
+		indices[j] = index;
+	}
+}
+
+// Squared distances from (x, y) of the AGENT_LANES walking enemies starting at slot first
+#if defined(__AVX__)
+static void Agent_WalkingDistances(const struct Walking_Enemies* walking, int first, float x, float y, float distances[]) {
+	__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&walking->x[first]), _mm256_set1_ps(x));
+	__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&walking->y[first]), _mm256_set1_ps(y));
+	_mm256_storeu_ps(distances, _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+}
+#elif defined(AGENT_SSE)
+static void Agent_WalkingDistances(const struct Walking_Enemies* walking, int first, float x, float y, float distances[]) {
+	__m128 dx = _mm_sub_ps(_mm_loadu_ps(&walking->x[first]), _mm_set1_ps(x));
+	__m128 dy = _mm_sub_ps(_mm_loadu_ps(&walking->y[first]), _mm_set1_ps(y));
+	_mm_storeu_ps(distances, _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+}
+#else
+static void Agent_WalkingDistances(const struct Walking_Enemies* walking, int first, float x, float y, float distances[]) {
+	for (int lane = 0; lane < AGENT_LANES; ++lane) {
+		float dx = walking->x[first + lane] - x, dy = walking->y[first + lane] - y;
+		distances[lane] = dx * dx + dy * dy;
+	}
+}
+#endif
+
+// Left and right edge of every platform of the row, one after the other. A missing platform has both edges at 0
+static void Agent_ObserveEdges(const struct Platform* row, float out[]) {
+#ifdef AGENT_SSE
+	__m128 isSolid = _mm_cmplt_ps(_mm_set_ps(3, 2, 1, 0), _mm_set1_ps((float)row->segmentCount)); // MAX_PLATFORM_SEGMENTS lanes
+	__m128 left = _mm_and_ps(_mm_mul_ps(_mm_load_ps(row->left), _mm_set1_ps(AGENT_PER_WIDTH)), isSolid);
+	__m128 right = _mm_and_ps(_mm_mul_ps(_mm_load_ps(row->right), _mm_set1_ps(AGENT_PER_WIDTH)), isSolid);
+	_mm_storeu_ps(&out[0], _mm_unpacklo_ps(left, right));
+	_mm_storeu_ps(&out[4], _mm_unpackhi_ps(left, right));
+#else
+	for (int j = 0; j < MAX_PLATFORM_SEGMENTS; ++j) {
+		out[j * 2] = j < row->segmentCount ? row->left[j] * AGENT_PER_WIDTH : 0.0f;
+		out[j * 2 + 1] = j < row->segmentCount ? row->right[j] * AGENT_PER_WIDTH : 0.0f;
+	}
+#endif
+}
+
+static void Agent_ObserveRows(const struct GameWorld* world, float observation[]) {
+	// Rows are sorted top to bottom, so the nearest below the player are the ones after the first row below it
+	const struct Platform* rows = world->platforms; // Indexed like GetPlatformRow does, without a call per row
+	int head = world->platformHead, count = world->platformCount;
+	float y = world->player.y;
+	int first = 0;
+	while (first < count && rows[(head + first) & (MAX_PLATFORMS - 1)].y * 100 - y <= 0) {
+		++first;
+	}
+
+	int j = 0;
+	for (; j < AGENT_PLATFORM_ROWS && first + j < count; ++j) {
+		const struct Platform* row = &rows[(head + first + j) & (MAX_PLATFORMS - 1)];
+		float* out = &observation[AGENT_OBSERVATION_ROWS + j * AGENT_ROW_FEATURES];
+		out[0] = (row->y * 100 - y) * AGENT_PER_HEIGHT;
+		Agent_ObserveEdges(row, &out[1]);
+	}
+	for (; j < AGENT_PLATFORM_ROWS; ++j) { // Slots with nothing in them
+		float* out = &observation[AGENT_OBSERVATION_ROWS + j * AGENT_ROW_FEATURES];
+		for (int k = 0; k < AGENT_ROW_FEATURES; ++k) {
+			out[k] = 0;
+		}
+	}
+}
+
+static void Agent_ObserveEnemies(const struct GameWorld* world, float observation[]) {
+	const struct Flying_Enemy* flying = world->flyingEnemies;
+	const struct Walking_Enemies* walking = &world->walkingEnemies;
+	float x = world->player.x, y = world->player.y;
+
+	// Squared distance of every enemy alive, Flying are kept as their index, Walking after them
+	float distances[MAX_FLYING_ENEMIES + WALKING_ENEMY_CAPACITY];
+	int indices[MAX_FLYING_ENEMIES + WALKING_ENEMY_CAPACITY];
+	int count = 0;
+	for (unsigned long long live = world->flyingEnemyPool.live; live; live &= live - 1) {
+		int i = Agent_FirstBit(live);
+		float dx = flying[i].x - x, dy = flying[i].y - y;
+		distances[count] = dx * dx + dy * dy;
+		indices[count++] = i;
+	}
+	for (int p = 0; p * POOL_CAPACITY < world->walkingEnemyCap; ++p) {
+		// Only groups of lanes with an enemy in them have their distances worked out, all lanes at once
+		unsigned long long live = walking->pools[p].live;
+		while (live) {
+			int lane = Agent_FirstBit(live) & ~(AGENT_LANES - 1);
+			unsigned int group = (unsigned int)(live >> lane) & ((1u << AGENT_LANES) - 1);
+			live &= ~((unsigned long long)group << lane);
+
+			float groupDistances[AGENT_LANES];
+			int first = p * POOL_CAPACITY + lane;
+			Agent_WalkingDistances(walking, first, x, y, groupDistances);
+			for (; group; group &= group - 1) {
+				int i = Agent_FirstBit(group);
+				distances[count] = groupDistances[i];
+				indices[count++] = MAX_FLYING_ENEMIES + first + i;
+			}
+		}
+	}
+
+	int n = count < AGENT_NEAREST_ENEMIES ? count : AGENT_NEAREST_ENEMIES;
+	if (count > 1) {
+		Agent_SortNearest(distances, indices, count, n);
+	}
+	int j = 0;
+	for (; j < n; ++j) {
+		float* out = &observation[AGENT_OBSERVATION_ENEMIES + j * AGENT_ENEMY_FEATURES];
+		int i = indices[j];
+		out[0] = 1;
+		if (i < MAX_FLYING_ENEMIES) {
+			out[1] = (flying[i].x - x) * AGENT_PER_WIDTH;
+			out[2] = (flying[i].y - y) * AGENT_PER_HEIGHT;
+			out[3] = 1;
+			out[4] = flying[i].enemyHealth * 0.01f; // In hundreds
+		} else {
+			out[1] = (walking->x[i - MAX_FLYING_ENEMIES] - x) * AGENT_PER_WIDTH;
+			out[2] = (walking->y[i - MAX_FLYING_ENEMIES] - y) * AGENT_PER_HEIGHT;
+			out[3] = 0;
+			out[4] = walking->health[i - MAX_FLYING_ENEMIES] * 0.01f;
+		}
+	}
+	for (; j < AGENT_NEAREST_ENEMIES; ++j) { // Slots with nothing in them
+		float* out = &observation[AGENT_OBSERVATION_ENEMIES + j * AGENT_ENEMY_FEATURES];
+		out[0] = out[1] = out[2] = out[3] = out[4] = 0;
+	}
+}
+
+static void Agent_ObserveBullets(const struct GameWorld* world, float observation[]) {
+	const struct Bullet* bullets = world->bullets;
+	float x = world->player.x, y = world->player.y;
+	float distances[MAX_BULLETS];
+	int indices[MAX_BULLETS];
+	int count = 0;
+	for (unsigned long long live = world->bulletPool.live; live; live &= live - 1) {
+		int i = Agent_FirstBit(live);
+		float dx = bullets[i].x - x, dy = bullets[i].y - y;
+		distances[count] = dx * dx + dy * dy;
+		indices[count++] = i;
+	}
+
+	int n = count < AGENT_NEAREST_BULLETS ? count : AGENT_NEAREST_BULLETS;
+	if (count > 1) {
+		Agent_SortNearest(distances, indices, count, n);
+	}
+	int j = 0;
+	for (; j < n; ++j) {
+		const struct Bullet* bullet = &bullets[indices[j]];
+		float* out = &observation[AGENT_OBSERVATION_BULLETS + j * AGENT_BULLET_FEATURES];
+		out[0] = 1;
+		out[1] = (bullet->x - x) * AGENT_PER_WIDTH;
+		out[2] = (bullet->y - y) * AGENT_PER_HEIGHT;
+		out[3] = bullet->directionX;
+		out[4] = bullet->directionY;
+	}
+	for (; j < AGENT_NEAREST_BULLETS; ++j) { // Slots with nothing in them
+		float* out = &observation[AGENT_OBSERVATION_BULLETS + j * AGENT_BULLET_FEATURES];
+		out[0] = out[1] = out[2] = out[3] = out[4] = 0;
+	}
+}
+
+static void Agent_ObservePickups(const struct GameWorld* world, float observation[]) {
+	const struct Pickups* pickups = world->pickups;
+	float x = world->player.x, y = world->player.y;
+	float distances[MAX_HEALTH_PICKUPS];
+	int indices[MAX_HEALTH_PICKUPS];
+	int count = 0;
+	for (unsigned long long live = world->pickupPool.live; live; live &= live - 1) {
+		int i = Agent_FirstBit(live);
+		float dx = pickups[i].x - x, dy = pickups[i].y - y;
+		distances[count] = dx * dx + dy * dy;
+		indices[count++] = i;
+	}
+
+	int n = count < AGENT_NEAREST_PICKUPS ? count : AGENT_NEAREST_PICKUPS;
+	if (count > 1) {
+		Agent_SortNearest(distances, indices, count, n);
+	}
+	int j = 0;
+	for (; j < n; ++j) {
+		float* out = &observation[AGENT_OBSERVATION_PICKUPS + j * AGENT_PICKUP_FEATURES];
+		out[0] = 1;
+		out[1] = (pickups[indices[j]].x - x) * AGENT_PER_WIDTH;
+		out[2] = (pickups[indices[j]].y - y) * AGENT_PER_HEIGHT;
+	}
+	for (; j < AGENT_NEAREST_PICKUPS; ++j) { // Slots with nothing in them
+		float* out = &observation[AGENT_OBSERVATION_PICKUPS + j * AGENT_PICKUP_FEATURES];
+		out[0] = out[1] = out[2] = 0;
+	}
+}
+
+static void Agent_ObserveHazards(const struct GameWorld* world, float observation[]) {
+	const struct Lazer_Hazard* lazers = world->lazerHazards;
+	float y = world->player.y;
+	float distances[MAX_LAZER_HAZARDS];
+	int indices[MAX_LAZER_HAZARDS];
+	int count = 0;
+	for (unsigned long long live = world->lazerHazardPool.live; live; live &= live - 1) { // Lazers go across the whole screen, only the height matters
+		int i = Agent_FirstBit(live);
+		distances[count] = fabsf(lazers[i].y - y);
+		indices[count++] = i;
+	}
+
+	int n = count < AGENT_NEAREST_HAZARDS ? count : AGENT_NEAREST_HAZARDS;
+	if (count > 1) {
+		Agent_SortNearest(distances, indices, count, n);
+	}
+	int j = 0;
+	for (; j < n; ++j) {
+		const struct Lazer_Hazard* lazer = &lazers[indices[j]];
+		float* out = &observation[AGENT_OBSERVATION_HAZARDS + j * AGENT_HAZARD_FEATURES];
+		out[0] = 1;
+		out[1] = (lazer->y - y) * AGENT_PER_HEIGHT;
+		out[2] = lazer->height * AGENT_PER_HEIGHT;
+		out[3] = lazer->timeCreated + lazer->timeToFire - world->gameTimer; // Below 0 once firing
+	}
+	for (; j < AGENT_NEAREST_HAZARDS; ++j) { // Slots with nothing in them
+		float* out = &observation[AGENT_OBSERVATION_HAZARDS + j * AGENT_HAZARD_FEATURES];
+		out[0] = out[1] = out[2] = out[3] = 0;
+	}
+}
+
+void Agent_Observe(const struct GameWorld* world, float observation[]) {
+	const struct Player* player = &world->player;
+	float* out = &observation[AGENT_OBSERVATION_PLAYER];
+	out[0] = (player->x - WINDOW_WIDTH / 2.0f) * (2 * AGENT_PER_WIDTH);
+	out[1] = (player->y - world->maxY) * AGENT_PER_HEIGHT; // Where on the screen
+	out[2] = player->horizontalVelocity * AGENT_PER_WIDTH;
+	out[3] = player->verticalVelocity * AGENT_PER_HEIGHT;
+	out[4] = player->maxHealth > 0 ? (float)player->currentHealth / player->maxHealth : 0.0f;
+	out[5] = (float)world->isTouching;
+	out[6] = (float)world->doubleJumpUsed;
+	out[7] = (float)world->fallingThroughPlatform;
+	out[8] = (float)(world->gameState == GAME_STATE_UPGRADE && !world->gameStateUpgrade.isUpgradeChosen);
+	out[9] = (float)player->totalUpgrades;
+
+	Agent_ObserveRows(world, observation);
+	Agent_ObserveEnemies(world, observation);
+	Agent_ObserveBullets(world, observation);
+	Agent_ObservePickups(world, observation);
+	Agent_ObserveHazards(world, observation);
+}
+
+#pragma endregion
+
+#pragma region act
+
+void Agent_Act(const struct GameWorld* world, const struct Agent_Action* action, struct Sim_Input* input) {
+	int wasJumping = input->wKeyPressed;
+	memset(input, 0, sizeof(*input));
+
+	input->aKeyPressed = action->move < 0;
+	input->dKeyPressed = action->move > 0;
+	input->wKeyPressed = action->jump != 0;
+	input->wKeyTriggered = action->jump != 0 && !wasJumping;
+	input->sKeyPressed = action->drop != 0;
+
+	if (action->upgrade >= 1 && action->upgrade <= 3) { // Click the middle of the card
+		input->mouseX = WINDOW_WIDTH * 0.25f * action->upgrade;
+		input->mouseY = world->maxY;
+		input->leftMouseClick = 1;
+	} else {
+		input->mouseX = world->player.x + action->aimX * WINDOW_WIDTH;
+		input->mouseY = world->player.y + action->aimY * WINDOW_HEIGHT;
+		input->leftMouseHold = action->shoot != 0;
+	}
+}
+
+void Agent_Reset(struct Agent* agent, unsigned long long seed, float observation[]) {
+	Sim_Init(&agent->world, seed);
+	memset(&agent->input, 0, sizeof(agent->input));
+	agent->steps = 0;
+	agent->actionRepeat = AGENT_ACTION_REPEAT;
+	Agent_Observe(&agent->world, observation);
+}
+
+int Agent_Step(struct Agent* agent, const struct Agent_Action* action, float observation[], float* reward) {
+	float maxY = agent->world.maxY;
+	Agent_Act(&agent->world, action, &agent->input);
+	for (int i = 0; i < agent->actionRepeat || i == 0; ++i) {
+		Sim_Step(&agent->world, &agent->input, 1.0f / SIM_STEPS_PER_SECOND);
+		agent->steps++;
+		agent->input.wKeyTriggered = 0;
+		agent->input.leftMouseClick = 0;
+		if (agent->world.gameState == GAME_STATE_DEFEAT) {
+			break;
+		}
+	}
+
+	if (reward != NULL) {
+		*reward = (agent->world.maxY - maxY) / 100.0f; // Rows are 100 apart
+	}
+	if (observation != NULL) {
+		Agent_Observe(&agent->world, observation);
+	}
+	return agent->world.gameState == GAME_STATE_DEFEAT;
+}
+
+#pragma endregion
@@ -0,0 +1,98 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: agent.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Agent API for Automated Playtesting
+//
+// brief:
+// Contains the declaration of functions in agent.c.
+// Lets scripted or learned bots play without a window: the world is turned
+// into a fixed size array of floats (the observation), and the bot answers
+// with an action, which is turned into the input of the next step.
+// Observations are relative to the player and scaled by the window size,
+// so most values are between -1 and 1. Slots with nothing in them are all 0.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+enum {
+	// Nearest things seen (Closest first)
+	AGENT_PLATFORM_ROWS = 3, // Rows below the player
+	AGENT_NEAREST_ENEMIES = 6, // Flying and Walking
+	AGENT_NEAREST_BULLETS = 4,
+	AGENT_NEAREST_PICKUPS = 2,
+	AGENT_NEAREST_HAZARDS = 3,
+	AGENT_ACTION_REPEAT = 1, // Steps each action is played for by default, an action every step
+
+	// Floats per thing seen
+	AGENT_PLAYER_FEATURES = 10, // x, screen y, velocity x, velocity y, health, touching, double jump used, falling through, choosing upgrade, upgrades
+	AGENT_ROW_FEATURES = 1 + 2 * MAX_PLATFORM_SEGMENTS, // dy, left and right edge of each platform
+	AGENT_ENEMY_FEATURES = 5, // seen, dx, dy, flying, health
+	AGENT_BULLET_FEATURES = 5, // seen, dx, dy, direction x, direction y
+	AGENT_PICKUP_FEATURES = 3, // seen, dx, dy
+	AGENT_HAZARD_FEATURES = 4, // seen, dy, height, seconds to fire
+
+	// Observation Layout (Index of the first float of each part)
+	AGENT_OBSERVATION_PLAYER = 0,
+	AGENT_OBSERVATION_ROWS = AGENT_OBSERVATION_PLAYER + AGENT_PLAYER_FEATURES,
+	AGENT_OBSERVATION_ENEMIES = AGENT_OBSERVATION_ROWS + AGENT_PLATFORM_ROWS * AGENT_ROW_FEATURES,
+	AGENT_OBSERVATION_BULLETS = AGENT_OBSERVATION_ENEMIES + AGENT_NEAREST_ENEMIES * AGENT_ENEMY_FEATURES,
+	AGENT_OBSERVATION_PICKUPS = AGENT_OBSERVATION_BULLETS + AGENT_NEAREST_BULLETS * AGENT_BULLET_FEATURES,
+	AGENT_OBSERVATION_HAZARDS = AGENT_OBSERVATION_PICKUPS + AGENT_NEAREST_PICKUPS * AGENT_PICKUP_FEATURES,
+	AGENT_OBSERVATION_SIZE = AGENT_OBSERVATION_HAZARDS + AGENT_NEAREST_HAZARDS * AGENT_HAZARD_FEATURES,
+};
+
+struct Agent_Action {
+	int move; // -1 for left, 0 to stand, 1 for right
+	int jump; // Held down while 1, a new jump needs an action of 0 first
+	int drop; // Climbs down through the platform (with the upgrade)
+	int shoot; // Fires at the aim while 1
+	float aimX, aimY; // Relative to the player, in window widths and heights like the observation
+	int upgrade; // 1 to 3 picks that upgrade on the upgrade screen, 0 for none
+};
+
+struct Agent {
+	struct GameWorld world;
+	struct Sim_Input input; // Input of the last step
+	long steps; // Steps since the last reset
+	int actionRepeat; // Steps each action is played for, observing is only done once for all of them
+};
+
+/// <summary>
+/// Fills in the observation of the world. Does not allocate.
+/// </summary>
+/// <param name="world">Address of Game World</param>
+/// <param name="observation">Array of size AGENT_OBSERVATION_SIZE. This will contain the output</param>
+void Agent_Observe(const struct GameWorld* world, float observation[]);
+
+/// <summary>
+/// Turns an action into the input of the next step.
+/// </summary>
+/// <param name="world">Address of Game World</param>
+/// <param name="action">Address of the Action</param>
+/// <param name="input">Address of the Input of the last step, replaced by the input of the next</param>
+void Agent_Act(const struct GameWorld* world, const struct Agent_Action* action, struct Sim_Input* input);
+
+/// <summary>
+/// Starts a new run. Action repeat is set back to AGENT_ACTION_REPEAT.
+/// </summary>
+/// <param name="agent">Address of the Agent</param>
+/// <param name="seed">Seed of the run</param>
+/// <param name="observation">Array of size AGENT_OBSERVATION_SIZE, the first observation of the run</param>
+void Agent_Reset(struct Agent* agent, unsigned long long seed, float observation[]);
+
+/// <summary>
+/// Plays an action for actionRepeat steps, or until the run is over.
+/// Presses (jumping, picking an upgrade) only happen on the first of them.
+/// </summary>
+/// <param name="agent">Address of the Agent</param>
+/// <param name="action">Address of the Action</param>
+/// <param name="observation">Array of size AGENT_OBSERVATION_SIZE, the observation after the steps. NULL to leave out</param>
+/// <param name="reward">Address of the Reward to fill in, rows gone down in the steps. NULL to leave out</param>
+/// <returns>1 once the run is over, else 0</returns>
+int Agent_Step(struct Agent* agent, const struct Agent_Action* action, float observation[], float* reward);
@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------------
+// file: assets.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Asset Registry for fonts
+//		Added Images and Sounds, kept across scenes with reference counts
+//		Added Image Pack, images in it are made from its pixels instead of their PNG
+//		Changed packed images whose PNG changed since packing to load the PNG
+//
+// brief:
+// Contains functions used to intern asset paths and load each asset once.
+// Paths are found through an open addressing table (FNV-1a hash of the path,
+// the next slot on a collision), and nothing is ever removed from it.
+// CProcessing has no way to free a font, so fonts are kept until the game closes.
+// Images and sounds are given back by their address, found by going through
+// the assets, which only happens when a scene exits.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#include <string.h>
+#include "cprocessing.h"
+#include "initialize.h"
+#include "assets.h"
+#include "pack.h"
+
+struct Asset {
+	char path[MAX_ASSET_FILEPATH];
+	enum Asset_Type type; // Set once a load was tried, an asset that failed to load is not tried every frame
+	int references; // Loads not released yet, images and sounds only
+	CP_Font font;
+	CP_Image image;
+	CP_Sound sound;
+};
+
+struct Asset assets[MAX_ASSETS];
+int assetTable[ASSET_TABLE_SIZE]; // Handle + 1 of the path hashed to the slot, 0 for empty
+struct Asset_Stats assetStats;
+struct Image_Pack assetPack; // Only changed before the loader thread starts, read only after
+
+unsigned int AssetPathHash(const char* path) {
+	unsigned int hash = 2166136261u;
+	for (; *path; ++path) {
+		hash = (hash ^ (unsigned char)*path) * 16777619u;
+	}
+	return hash;
+}
+
+int Assets_Intern(const char* path) {
+	if (strlen(path) >= MAX_ASSET_FILEPATH) {
+		return -1;
+	}
+	for (unsigned int slot = AssetPathHash(path) & (ASSET_TABLE_SIZE - 1);; slot = (slot + 1) & (ASSET_TABLE_SIZE - 1)) {
+		int handle = assetTable[slot] - 1;
+		if (handle < 0) { // Not interned yet
+			if (assetStats.assets >= MAX_ASSETS) {
+				return -1;
+			}
+			handle = assetStats.assets++;
+			strcpy_s(assets[handle].path, MAX_ASSET_FILEPATH, path);
+			assetTable[slot] = handle + 1;
+			return handle;
+		}
+		if (strcmp(assets[handle].path, path) == 0) {
+			return handle;
+		}
+	}
+}
+
+int Assets_LoadFont(const char* path) {
+	int handle = Assets_Intern(path);
+	if (handle < 0) {
+		return -1;
+	}
+	if (assets[handle].type != ASSET_NONE) {
+		assetStats.hits++;
+	} else {
+		assets[handle].font = CP_Font_Load(path);
+		assets[handle].type = ASSET_FONT;
+		assetStats.misses++;
+	}
+	return handle;
+}
+
+CP_Font Assets_GetFont(int handle) {
+	return handle < 0 ? NULL : assets[handle].font;
+}
+
+int Assets_OpenPack(const char* path) {
+	Pack_Close(&assetPack);
+	return Pack_Open(&assetPack, path);
+}
+
+void Assets_ClosePack(void) {
+	Pack_Close(&assetPack);
+}
+
+// Entry of an image in the pack, NULL if it is not in there or its PNG changed since it was packed
+const struct Pack_Entry* AssetsFindPacked(const char* path) {
+	const struct Pack_Entry* entry = Pack_Find(&assetPack, path);
+	return entry != NULL && Pack_IsCurrent(entry) ? entry : NULL;
+}
+
+const unsigned char* Assets_GetPackedPixels(const char* path, size_t* size) {
+	const struct Pack_Entry* entry = AssetsFindPacked(path);
+	if (entry == NULL) {
+		return NULL;
+	}
+	*size = (size_t)entry->width * entry->height * 4;
+	return Pack_GetPixels(&assetPack, entry);
+}
+
+// Makes an image from the pack if it is in there, else loads its PNG
+CP_Image AssetsMakeImage(const char* path) {
+	const struct Pack_Entry* entry = AssetsFindPacked(path);
+	if (entry == NULL) {
+		return CP_Image_Load(path);
+	}
+	assetStats.packed++;
+	return CP_Image_CreateFromData((int)entry->width, (int)entry->height, Pack_GetPixels(&assetPack, entry));
+}
+
+// Interns the path and loads it if it is not loaded yet, adding a reference. -1 if it could not be interned
+int AssetsLoad(const char* path, enum Asset_Type type) {
+	int handle = Assets_Intern(path);
+	if (handle < 0) {
+		return -1;
+	}
+	struct Asset* asset = &assets[handle];
+	if (asset->type != ASSET_NONE) {
+		assetStats.hits++;
+	} else {
+		if (type == ASSET_IMAGE) {
+			asset->image = AssetsMakeImage(path);
+		} else if (type == ASSET_SOUND) {
+			asset->sound = CP_Sound_Load(path);
+		} else {
+			asset->sound = CP_Sound_LoadMusic(path);
+		}
+		asset->type = type;
+		assetStats.misses++;
+	}
+	asset->references++;
+	return handle;
+}
+
+CP_Image Assets_LoadImage(const char* path) {
+	int handle = AssetsLoad(path, ASSET_IMAGE);
+	return handle < 0 ? AssetsMakeImage(path) : assets[handle].image; // Still loads when the registry is full
+}
+
+CP_Sound Assets_LoadSound(const char* path) {
+	int handle = AssetsLoad(path, ASSET_SOUND);
+	return handle < 0 ? CP_Sound_Load(path) : assets[handle].sound;
+}
+
+CP_Sound Assets_LoadMusic(const char* path) {
+	int handle = AssetsLoad(path, ASSET_MUSIC);
+	return handle < 0 ? CP_Sound_LoadMusic(path) : assets[handle].sound;
+}
+
+void Assets_ReleaseImage(CP_Image* image) {
+	if (*image == NULL) {
+		return;
+	}
+	for (int i = 0; i < assetStats.assets; ++i) {
+		if (assets[i].type == ASSET_IMAGE && assets[i].image == *image) {
+			if (assets[i].references > 0) {
+				assets[i].references--;
+			}
+			*image = NULL;
+			return;
+		}
+	}
+	CP_Image_Free(image); // Not from the registry
+}
+
+void Assets_ReleaseSound(CP_Sound* sound) {
+	if (*sound == NULL) {
+		return;
+	}
+	for (int i = 0; i < assetStats.assets; ++i) {
+		if ((assets[i].type == ASSET_SOUND || assets[i].type == ASSET_MUSIC) && assets[i].sound == *sound) {
+			if (assets[i].references > 0) {
+				assets[i].references--;
+			}
+			*sound = NULL;
+			return;
+		}
+	}
+	CP_Sound_Free(sound); // Not from the registry
+}
+
+int Assets_Evict(void) {
+	int evicted = 0;
+	for (int i = 0; i < assetStats.assets; ++i) {
+		struct Asset* asset = &assets[i];
+		if (asset->references > 0 || asset->type == ASSET_NONE || asset->type == ASSET_FONT) {
+			continue;
+		}
+		if (asset->type == ASSET_IMAGE) {
+			CP_Image_Free(&asset->image);
+		} else {
+			CP_Sound_Free(&asset->sound);
+		}
+		asset->type = ASSET_NONE;
+		evicted++;
+	}
+	assetStats.evictions += evicted;
+	return evicted;
+}
+
+void Assets_GetStats(struct Asset_Stats* stats) {
+	*stats = assetStats;
+}
@@ -0,0 +1,147 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: assets.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Asset Registry for fonts
+//		Added Images and Sounds, kept across scenes with reference counts
+//		Added Image Pack, images in it are made from its pixels instead of their PNG
+//
+// brief:
+// Contains the declaration of functions in assets.c.
+// Keeps every asset loaded for as long as the game runs, keyed by its path.
+// Each path is interned once and given a handle (a small int), so asking for
+// the same file again is a table lookup instead of loading it again, and code
+// that keeps the handle only indexes an array.
+//
+// Loading once, using every frame:
+//	int font = Assets_LoadFont("Assets/Fonts/Exo2-Regular.ttf"); // In Init
+//	CP_Font_Set(Assets_GetFont(font)); // In Update
+//
+// Images and sounds are handed out as they are, in place of CP_Image_Load and
+// CP_Sound_Load, and given back in place of CP_Image_Free and CP_Sound_Free.
+// Each load adds a reference and each release takes one away, but nothing is
+// freed at 0: the next scene (or the same one after Respawn) that loads the
+// file gets it straight back. Only Assets_Evict frees them.
+//
+// When an image pack (see pack.h) is opened with Assets_OpenPack, images in it
+// are made from its decoded pixels, and only images missing from it (or every
+// image, when there is no pack) are loaded from their PNG. So are images whose
+// PNG changed since the pack was made.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+enum {
+	MAX_ASSETS = 128, // Paths that can be interned
+	ASSET_TABLE_SIZE = 256, // Slots of the path table, a power of two at least twice MAX_ASSETS
+};
+
+enum Asset_Type {
+	ASSET_NONE, // Interned, never loaded
+	ASSET_FONT,
+	ASSET_IMAGE,
+	ASSET_SOUND,
+	ASSET_MUSIC, // Streamed with CP_Sound_LoadMusic
+};
+
+struct Asset_Stats {
+	int assets; // Paths interned
+	int hits; // Loads of a path that was already loaded
+	int misses; // Loads that went to the disk
+	int evictions; // Images and sounds freed by Assets_Evict
+	int packed; // Images made from the image pack instead of their PNG
+};
+
+/// <summary>
+/// Opens the image pack that images are made from. Run this before loading any image.
+/// </summary>
+/// <param name="path">Pack File, PACK_FILE</param>
+/// <returns>1 if opened, 0 if there is no pack (or an old one), images are then loaded from their PNG</returns>
+int Assets_OpenPack(const char* path);
+
+/// <summary>
+/// Closes the image pack. Images already made from it stay loaded.
+/// </summary>
+void Assets_ClosePack(void);
+
+/// <summary>
+/// Gets the pixels of an image in the image pack, without making the image. Safe from any thread while the pack is open.
+/// </summary>
+/// <param name="path">Image file path</param>
+/// <param name="size">Address of the size to fill in, in bytes</param>
+/// <returns>RGBA pixels, NULL if the image is not in the pack or its PNG changed since</returns>
+const unsigned char* Assets_GetPackedPixels(const char* path, size_t* size);
+
+/// <summary>
+/// Gets the handle of a path, interning it the first time. Does not load anything.
+/// </summary>
+/// <param name="path">File path, relative to the game folder</param>
+/// <returns>Handle, the same for every call with the same path. -1 if the path is too long or the table is full</returns>
+int Assets_Intern(const char* path);
+
+/// <summary>
+/// Loads a font the first time its path is asked for. Later calls only look the path up.
+/// </summary>
+/// <param name="path">Font file path</param>
+/// <returns>Handle of the font, -1 if it could not be interned</returns>
+int Assets_LoadFont(const char* path);
+
+/// <summary>
+/// Gets a font loaded with Assets_LoadFont.
+/// </summary>
+/// <param name="handle">Handle from Assets_LoadFont</param>
+/// <returns>The font, NULL for -1</returns>
+CP_Font Assets_GetFont(int handle);
+
+/// <summary>
+/// Loads an image the first time its path is asked for, and adds a reference to it.
+/// </summary>
+/// <param name="path">Image file path</param>
+/// <returns>The image, NULL if it could not be loaded</returns>
+CP_Image Assets_LoadImage(const char* path);
+
+/// <summary>
+/// Loads a sound effect the first time its path is asked for, and adds a reference to it.
+/// </summary>
+/// <param name="path">Sound file path</param>
+/// <returns>The sound, NULL if it could not be loaded</returns>
+CP_Sound Assets_LoadSound(const char* path);
+
+/// <summary>
+/// Loads a music track (streamed from the disk while it plays) the first time its path is asked for, and adds a reference to it.
+/// </summary>
+/// <param name="path">Music file path</param>
+/// <returns>The music, NULL if it could not be loaded</returns>
+CP_Sound Assets_LoadMusic(const char* path);
+
+/// <summary>
+/// Takes away a reference to an image. It stays loaded until Assets_Evict.
+/// An image that did not come from Assets_LoadImage is freed.
+/// </summary>
+/// <param name="image">Address of the Image, set to NULL</param>
+void Assets_ReleaseImage(CP_Image* image);
+
+/// <summary>
+/// Takes away a reference to a sound or music track. It stays loaded until Assets_Evict.
+/// A sound that did not come from Assets_LoadSound or Assets_LoadMusic is freed.
+/// </summary>
+/// <param name="sound">Address of the Sound, set to NULL</param>
+void Assets_ReleaseSound(CP_Sound* sound);
+
+/// <summary>
+/// Frees every image and sound with no references left. Their paths stay
+/// interned, loading them again goes to the disk. Fonts are never freed.
+/// </summary>
+/// <returns>Number of assets freed</returns>
+int Assets_Evict(void);
+
+/// <summary>
+/// Gets how many assets are loaded and how many loads were found already loaded.
+/// </summary>
+/// <param name="stats">Address of the Stats to fill in</param>
+void Assets_GetStats(struct Asset_Stats* stats);
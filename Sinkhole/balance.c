@@ -0,0 +1,617 @@
+//------------------------------------------------------------------------------------
+// file: balance.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Monte Carlo Balance Runner
+//		Added Difficulty Curve Fitting
+//
+// brief:
+// Plays thousands of seeded runs with the scripted bot (bot.c) on every
+// core, and sums up how deep runs get, kills, upgrade picks, what the
+// player got hit by, and how long runs survive. Writes the runs and the
+// histograms to CSV files for tuning the DIFFICULTY_* values.
+// Given a target depth histogram, it can also tune them itself: it searches
+// for the difficulty whose runs come closest and writes it out as enum lines.
+// Not part of the Visual Studio build, see README.md for the command line.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#define _CRT_SECURE_NO_WARNINGS // Command line tool, plain fopen is fine
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#include "initialize.h"
+#include "bot.h"
+#include "sim.h"
+#include "balance.h"
+
+#pragma region threads
+
+#ifdef _WIN32
+typedef HANDLE Balance_Thread;
+
+DWORD WINAPI Balance_ThreadMain(LPVOID job) {
+	Balance_Worker(job);
+	return 0;
+}
+
+int Balance_StartThread(Balance_Thread* thread, struct Balance_Job* job) {
+	*thread = CreateThread(NULL, 0, Balance_ThreadMain, job, 0, NULL);
+	return *thread != NULL;
+}
+
+void Balance_JoinThread(Balance_Thread thread) {
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+}
+
+int Balance_CountCores(void) {
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int)info.dwNumberOfProcessors;
+}
+
+long Balance_NextRun(struct Balance_Job* job) {
+	return InterlockedIncrement(&job->nextRun) - 1;
+}
+#else
+typedef pthread_t Balance_Thread;
+
+void* Balance_ThreadMain(void* job) {
+	Balance_Worker(job);
+	return NULL;
+}
+
+int Balance_StartThread(Balance_Thread* thread, struct Balance_Job* job) {
+	return pthread_create(thread, NULL, Balance_ThreadMain, job) == 0;
+}
+
+void Balance_JoinThread(Balance_Thread thread) {
+	pthread_join(thread, NULL);
+}
+
+int Balance_CountCores(void) {
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	return cores > 0 ? (int)cores : 1;
+}
+
+long Balance_NextRun(struct Balance_Job* job) {
+	return __atomic_fetch_add(&job->nextRun, 1, __ATOMIC_RELAXED);
+}
+#endif
+
+#pragma endregion
+
+#pragma region runs
+
+void Balance_PlayRun(struct Balance_Run* run, unsigned long long seed, float maxSeconds, const struct Difficulty* difficulty) {
+	struct GameWorld world;
+	struct Sim_Input input;
+	Sim_Init(&world, seed);
+	world.difficulty = *difficulty;
+
+	float dt = 1.0f / SIM_STEPS_PER_SECOND;
+	long maxSteps = (long)(maxSeconds * SIM_STEPS_PER_SECOND);
+	long step = 0;
+	run->killedBy = -1;
+	while (world.gameState != GAME_STATE_DEFEAT && step < maxSteps) {
+		int damageTaken[MAX_DAMAGE_SOURCES];
+		memcpy(damageTaken, world.damageTaken, sizeof(damageTaken));
+
+		BotInput(&world, &input);
+		Sim_Step(&world, &input, dt);
+		step++;
+
+		for (int i = 0; i < MAX_DAMAGE_SOURCES; ++i) { // Defeat only shows a step after the last hit, so keep track of every hit
+			if (world.damageTaken[i] > damageTaken[i]) {
+				run->killedBy = i;
+			}
+		}
+	}
+	if (world.gameState != GAME_STATE_DEFEAT) {
+		run->killedBy = -1;
+	}
+
+	run->seed = seed;
+	run->seconds = (float)step / SIM_STEPS_PER_SECOND;
+	run->survived = world.gameState != GAME_STATE_DEFEAT;
+	run->depth = (int)world.maxY - 347;
+	run->kills = world.player.killCount;
+	memcpy(run->upgrades, world.player.upgrades, sizeof(run->upgrades));
+	memcpy(run->damageTaken, world.damageTaken, sizeof(run->damageTaken));
+}
+
+void Balance_Worker(struct Balance_Job* job) {
+	for (long i = Balance_NextRun(job); i < job->runCount; i = Balance_NextRun(job)) {
+		// Same seeds as the restarts of the headless runner, any run can be recorded there
+		Balance_PlayRun(&job->runs[i], job->seed ^ ((unsigned long long)i << 32), job->maxSeconds, &job->difficulty);
+	}
+}
+
+int Balance_RunAll(struct Balance_Job* job, int threadCount) {
+	Balance_Thread* threads = malloc(sizeof(Balance_Thread) * threadCount);
+	if (threads == NULL) {
+		return 0;
+	}
+	job->nextRun = 0;
+
+	int started = 0;
+	for (int i = 0; i < threadCount; ++i) {
+		started += Balance_StartThread(&threads[started], job);
+	}
+	if (started == 0) { // No threads, play them all here
+		Balance_Worker(job);
+	}
+	for (int i = 0; i < started; ++i) {
+		Balance_JoinThread(threads[i]);
+	}
+	free(threads);
+	return 1;
+}
+
+#pragma endregion
+
+#pragma region results
+
+int CompareInts(const void* a, const void* b) {
+	return (*(const int*)a > *(const int*)b) - (*(const int*)a < *(const int*)b);
+}
+
+void Balance_GetSummary(const struct Balance_Run runs[], int runCount, struct Balance_Summary* summary) {
+	memset(summary, 0, sizeof(*summary));
+	if (runCount <= 0) {
+		return;
+	}
+
+	int* depths = malloc(sizeof(int) * runCount);
+	double depthSum = 0, killSum = 0, secondsSum = 0;
+	for (int i = 0; i < runCount; ++i) {
+		if (depths != NULL) {
+			depths[i] = runs[i].depth;
+		}
+		depthSum += runs[i].depth;
+		killSum += runs[i].kills;
+		secondsSum += runs[i].seconds;
+		summary->survived += runs[i].survived;
+		for (int u = 0; u < MAX_UPGRADES; ++u) {
+			summary->upgradePicks[u] += runs[i].upgrades[u];
+		}
+		for (int d = 0; d < MAX_DAMAGE_SOURCES; ++d) {
+			summary->damageTaken[d] += runs[i].damageTaken[d];
+		}
+		if (runs[i].killedBy >= 0) {
+			summary->killedBy[runs[i].killedBy]++;
+		}
+	}
+	summary->meanDepth = (float)(depthSum / runCount);
+	summary->meanKills = (float)(killSum / runCount);
+	summary->meanSeconds = (float)(secondsSum / runCount);
+	summary->simulatedSeconds = secondsSum;
+
+	if (depths != NULL) {
+		qsort(depths, runCount, sizeof(int), CompareInts);
+		summary->depthP10 = depths[runCount / 10];
+		summary->depthP50 = depths[runCount / 2];
+		summary->depthP90 = depths[runCount * 9 / 10];
+		free(depths);
+	}
+}
+
+int Balance_WriteCsv(const struct Balance_Run runs[], int runCount, float maxSeconds, const char* prefix) {
+	char path[MAX_ASSET_FILEPATH];
+	int isWritten = 1;
+
+	// Every run
+	snprintf(path, sizeof(path), "%s_runs.csv", prefix);
+	FILE* file = fopen(path, "w");
+	if (file != NULL) {
+		fprintf(file, "run,seed,seconds,survived,depth,kills,damage_flying,damage_walking,damage_lazer,killed_by");
+		for (int u = 0; u < MAX_UPGRADES; ++u) {
+			fprintf(file, ",upgrade_%d", u);
+		}
+		fprintf(file, "\n");
+		for (int i = 0; i < runCount; ++i) {
+			const struct Balance_Run* run = &runs[i];
+			fprintf(file, "%d,%llu,%.2f,%d,%d,%d,%d,%d,%d,%s", i, run->seed, run->seconds, run->survived, run->depth, run->kills,
+				run->damageTaken[DAMAGE_SOURCE_FLYING], run->damageTaken[DAMAGE_SOURCE_WALKING], run->damageTaken[DAMAGE_SOURCE_LAZER],
+				Balance_GetDamageSourceName(run->killedBy));
+			for (int u = 0; u < MAX_UPGRADES; ++u) {
+				fprintf(file, ",%d", run->upgrades[u]);
+			}
+			fprintf(file, "\n");
+		}
+		isWritten = fclose(file) == 0 && isWritten;
+	} else {
+		isWritten = 0;
+	}
+
+	// Depth Histogram
+	snprintf(path, sizeof(path), "%s_depth.csv", prefix);
+	file = fopen(path, "w");
+	if (file != NULL) {
+		int buckets[BALANCE_DEPTH_BUCKETS] = { 0 };
+		for (int i = 0; i < runCount; ++i) {
+			int bucket = runs[i].depth / BALANCE_DEPTH_BUCKET_SIZE;
+			buckets[bucket < 0 ? 0 : bucket >= BALANCE_DEPTH_BUCKETS ? BALANCE_DEPTH_BUCKETS - 1 : bucket]++;
+		}
+		fprintf(file, "depth_from,depth_to,runs\n");
+		for (int b = 0; b < BALANCE_DEPTH_BUCKETS; ++b) {
+			fprintf(file, "%d,%d,%d\n", b * BALANCE_DEPTH_BUCKET_SIZE, (b + 1) * BALANCE_DEPTH_BUCKET_SIZE, buckets[b]);
+		}
+		isWritten = fclose(file) == 0 && isWritten;
+	} else {
+		isWritten = 0;
+	}
+
+	// Survival Curve
+	snprintf(path, sizeof(path), "%s_survival.csv", prefix);
+	file = fopen(path, "w");
+	if (file != NULL) {
+		fprintf(file, "seconds,alive\n");
+		for (int t = 0; t <= (int)maxSeconds; t += BALANCE_SURVIVAL_STEP_SECONDS) {
+			fprintf(file, "%d,%.4f\n", t, Balance_GetAliveFraction(runs, runCount, (float)t));
+		}
+		isWritten = fclose(file) == 0 && isWritten;
+	} else {
+		isWritten = 0;
+	}
+
+	return isWritten;
+}
+
+float Balance_GetAliveFraction(const struct Balance_Run runs[], int runCount, float seconds) {
+	int alive = 0;
+	for (int i = 0; i < runCount; ++i) {
+		alive += runs[i].survived || runs[i].seconds > seconds;
+	}
+	return runCount > 0 ? (float)alive / runCount : 0.0f;
+}
+
+const char* Balance_GetDamageSourceName(int source) {
+	switch (source) {
+	case DAMAGE_SOURCE_FLYING:
+		return "flying";
+	case DAMAGE_SOURCE_WALKING:
+		return "walking";
+	case DAMAGE_SOURCE_LAZER:
+		return "lazer";
+	default:
+		return "none";
+	}
+}
+
+void PrintBar(float fraction) {
+	int width = (int)(fraction * 50 + 0.5f);
+	for (int i = 0; i < width; ++i) {
+		putchar('#');
+	}
+	putchar('\n');
+}
+
+void Balance_PrintSummary(const struct Balance_Run runs[], int runCount, float maxSeconds, const struct Balance_Summary* summary) {
+	printf("depth: mean %.0f, p10 %d, p50 %d, p90 %d\n", summary->meanDepth, summary->depthP10, summary->depthP50, summary->depthP90);
+	printf("kills: mean %.1f, survived %.0fs on average, %d of %d runs reached the %.0fs limit\n", summary->meanKills, summary->meanSeconds, summary->survived, runCount, maxSeconds);
+
+	printf("\nhits taken (killing blow):\n");
+	for (int d = 0; d < MAX_DAMAGE_SOURCES; ++d) {
+		printf("  %-8s %8ld (%ld)\n", Balance_GetDamageSourceName(d), summary->damageTaken[d], summary->killedBy[d]);
+	}
+
+	printf("\nupgrade picks:\n");
+	for (int u = 0; u < MAX_UPGRADES; ++u) {
+		printf("  upgrade %-2d %8ld\n", u, summary->upgradePicks[u]);
+	}
+
+	int buckets[BALANCE_DEPTH_BUCKETS] = { 0 };
+	int largest = 1;
+	for (int i = 0; i < runCount; ++i) {
+		int bucket = runs[i].depth / BALANCE_DEPTH_BUCKET_SIZE;
+		bucket = bucket < 0 ? 0 : bucket >= BALANCE_DEPTH_BUCKETS ? BALANCE_DEPTH_BUCKETS - 1 : bucket;
+		buckets[bucket]++;
+		largest = buckets[bucket] > largest ? buckets[bucket] : largest;
+	}
+	printf("\ndepth reached:\n");
+	for (int b = 0; b < BALANCE_DEPTH_BUCKETS; ++b) {
+		if (buckets[b] > 0) {
+			printf("  %6d %6d ", b * BALANCE_DEPTH_BUCKET_SIZE, buckets[b]);
+			PrintBar((float)buckets[b] / largest);
+		}
+	}
+
+	printf("\nstill alive after:\n");
+	for (int t = 0; t <= (int)maxSeconds; t += BALANCE_SURVIVAL_STEP_SECONDS * 3) {
+		float alive = Balance_GetAliveFraction(runs, runCount, (float)t);
+		printf("  %5ds %5.1f%% ", t, alive * 100);
+		PrintBar(alive);
+		if (alive == 0) {
+			break;
+		}
+	}
+}
+
+#pragma endregion
+
+#pragma region fitting
+
+// Every DIFFICULTY_* value the fit may change, and how far
+static const struct Balance_Parameter BALANCE_PARAMETERS[] = {
+	{ "DIFFICULTY_FLYING_ENEMIES_SPAWN_TIME", offsetof(struct Difficulty, flyingEnemiesSpawnTime), 1, 10, 2 },
+	{ "DIFFICULTY_HEALTH_INCREMENT_FLYING_ENEMIES_MODIFIER", offsetof(struct Difficulty, flyingEnemiesHealthIncrement), 0, 30, 4 },
+	{ "DIFFICULTY_MIN_FLYING_ENEMIES_HEALTH", offsetof(struct Difficulty, minFlyingEnemiesHealth), 5, 60, 8 },
+	{ "DIFFICULTY_SPEED_INCREMENT_FLYING_ENEMIES_MODIFIER", offsetof(struct Difficulty, flyingEnemiesSpeedIncrement), 0, 6, 1 },
+	{ "DIFFICULTY_MIN_FLYING_ENEMIES_SPEED", offsetof(struct Difficulty, minFlyingEnemiesSpeed), 1, 8, 1 },
+
+	{ "DIFFICULTY_MIN_WALKING_ENEMIES", offsetof(struct Difficulty, minWalkingEnemies), 1, 3, 1 },
+	{ "DIFFICULTY_MAX_WALKING_ENEMIES", offsetof(struct Difficulty, maxWalkingEnemies), 1, 6, 1 },
+	{ "DIFFICULTY_HEALTH_INCREMENT_WALKING_ENEMIES_MODIFIER", offsetof(struct Difficulty, walkingEnemiesHealthIncrement), 0, 60, 8 },
+	{ "DIFFICULTY_MIN_WALKING_ENEMIES_HEALTH", offsetof(struct Difficulty, minWalkingEnemiesHealth), 5, 100, 8 },
+	{ "DIFFICULTY_SPEED_INCREMENT_WALKING_ENEMIES_MODIFIER", offsetof(struct Difficulty, walkingEnemiesSpeedIncrement), 0, 6, 1 },
+	{ "DIFFICULTY_MIN_WALKING_ENEMIES_SPEED", offsetof(struct Difficulty, minWalkingEnemiesSpeed), 1, 10, 2 },
+
+	{ "DIFFICULTY_MIN_SPAWN_PERCENTAGE_MODIFIER", offsetof(struct Difficulty, minSpawnPercentage), 0, 100, 8 },
+	{ "DIFFICULTY_MAX_SPAWN_PERCENTAGE_MODIFIER", offsetof(struct Difficulty, maxSpawnPercentage), 0, 100, 8 },
+	{ "DIFFICULTY_SPAWN_PERCENTAGE_INCREMENT_MODIFIER", offsetof(struct Difficulty, spawnPercentageIncrement), 0, 20, 2 },
+
+	{ "DIFFICULTY_MIN_HAZARD_TIME_TO_FIRE_MODIFIER", offsetof(struct Difficulty, minHazardTimeToFire), 1, 6, 1 },
+	{ "DIFFICULTY_MAX_HAZARD_TIME_TO_FIRE_MODIFIER", offsetof(struct Difficulty, maxHazardTimeToFire), 0, 6, 1 },
+	{ "DIFFICULTY_MIN_HAZARD_HEIGHT_MODIFIER", offsetof(struct Difficulty, minHazardHeight), 20, 200, 16 },
+	{ "DIFFICULTY_HAZARD_HEIGHT_INCREMENT_MODIFIER", offsetof(struct Difficulty, hazardHeightIncrement), 0, 30, 4 },
+	{ "DIFFICULTY_MAX_HAZARD_HEIGHT_MODIFIER", offsetof(struct Difficulty, maxHazardHeight), 20, 300, 16 },
+	{ "DIFFICULTY_MIN_HAZARD_SPAWN_TIME", offsetof(struct Difficulty, minHazardSpawnTime), 1, 15, 2 },
+	{ "DIFFICULTY_MAX_HAZARD_SPAWN_TIME", offsetof(struct Difficulty, maxHazardSpawnTime), 1, 15, 2 },
+};
+static const int BALANCE_PARAMETER_COUNT = sizeof(BALANCE_PARAMETERS) / sizeof(BALANCE_PARAMETERS[0]);
+
+int* Balance_GetParameter(struct Difficulty* difficulty, int parameter) {
+	return (int*)((char*)difficulty + BALANCE_PARAMETERS[parameter].offset);
+}
+
+int Balance_ReadDepthCsv(const char* path, float target[]) {
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		return 0;
+	}
+
+	long total = 0;
+	long buckets[BALANCE_DEPTH_BUCKETS] = { 0 };
+	char line[256];
+	while (fgets(line, sizeof(line), file) != NULL) {
+		int from, to, runs;
+		if (sscanf(line, "%d,%d,%d", &from, &to, &runs) == 3 && runs > 0) { // Skips the header
+			int bucket = from / BALANCE_DEPTH_BUCKET_SIZE;
+			buckets[bucket < 0 ? 0 : bucket >= BALANCE_DEPTH_BUCKETS ? BALANCE_DEPTH_BUCKETS - 1 : bucket] += runs;
+			total += runs;
+		}
+	}
+	fclose(file);
+
+	for (int b = 0; b < BALANCE_DEPTH_BUCKETS; ++b) {
+		target[b] = total > 0 ? (float)buckets[b] / total : 0.0f;
+	}
+	return total > 0;
+}
+
+float Balance_GetDepthLoss(const struct Balance_Run runs[], int runCount, const float target[]) {
+	int buckets[BALANCE_DEPTH_BUCKETS] = { 0 };
+	for (int i = 0; i < runCount; ++i) {
+		int bucket = runs[i].depth / BALANCE_DEPTH_BUCKET_SIZE;
+		buckets[bucket < 0 ? 0 : bucket >= BALANCE_DEPTH_BUCKETS ? BALANCE_DEPTH_BUCKETS - 1 : bucket]++;
+	}
+
+	double runsBelow = 0, targetBelow = 0, area = 0;
+	for (int b = 0; b < BALANCE_DEPTH_BUCKETS - 1; ++b) { // Both reach 1 after the last bar
+		runsBelow += (double)buckets[b] / runCount;
+		targetBelow += target[b];
+		area += (runsBelow > targetBelow ? runsBelow - targetBelow : targetBelow - runsBelow) * BALANCE_DEPTH_BUCKET_SIZE;
+	}
+	return (float)area;
+}
+
+int Balance_IsValidDifficulty(const struct Difficulty* difficulty) {
+	return difficulty->minWalkingEnemies >= 1 // At least 1 enemy is rolled for
+		&& difficulty->minWalkingEnemies <= difficulty->maxWalkingEnemies
+		&& difficulty->minSpawnPercentage <= difficulty->maxSpawnPercentage
+		&& difficulty->maxHazardTimeToFire <= difficulty->minHazardTimeToFire // Time to fire goes down
+		&& difficulty->minHazardHeight <= difficulty->maxHazardHeight
+		&& difficulty->minHazardSpawnTime <= difficulty->maxHazardSpawnTime;
+}
+
+float Balance_GetJobLoss(struct Balance_Job* job, int threadCount, const float target[]) {
+	Balance_RunAll(job, threadCount);
+	return Balance_GetDepthLoss(job->runs, job->runCount, target);
+}
+
+float Balance_FitDifficulty(struct Balance_Job* job, int threadCount, const float target[], int maxSweeps) {
+	int steps[sizeof(BALANCE_PARAMETERS) / sizeof(BALANCE_PARAMETERS[0])];
+	for (int p = 0; p < BALANCE_PARAMETER_COUNT; ++p) {
+		steps[p] = BALANCE_PARAMETERS[p].step;
+	}
+
+	float bestLoss = Balance_GetJobLoss(job, threadCount, target);
+	printf("start: distance %.1f\n", bestLoss);
+	fflush(stdout); // Fits take minutes, show how it is going
+	for (int sweep = 0; sweep < maxSweeps; ++sweep) {
+		int isImproved = 0;
+		for (int p = 0; p < BALANCE_PARAMETER_COUNT; ++p) {
+			const struct Balance_Parameter* parameter = &BALANCE_PARAMETERS[p];
+			int* value = Balance_GetParameter(&job->difficulty, p);
+			int start = *value;
+			for (int direction = 1; direction >= -1; direction -= 2) {
+				int candidate = start + direction * steps[p];
+				candidate = candidate < parameter->min ? parameter->min : candidate > parameter->max ? parameter->max : candidate;
+				*value = candidate;
+				if (candidate == start || !Balance_IsValidDifficulty(&job->difficulty)) {
+					*value = start;
+					continue;
+				}
+
+				float loss = Balance_GetJobLoss(job, threadCount, target);
+				if (loss < bestLoss) {
+					printf("sweep %d: %s %d -> %d, distance %.1f\n", sweep + 1, parameter->name, start, candidate, loss);
+					fflush(stdout);
+					bestLoss = loss;
+					isImproved = 1;
+					break;
+				}
+				*value = start;
+			}
+		}
+
+		if (!isImproved) {
+			int isSmallest = 1;
+			for (int p = 0; p < BALANCE_PARAMETER_COUNT; ++p) {
+				isSmallest = isSmallest && steps[p] == 1;
+				steps[p] = steps[p] > 1 ? steps[p] / 2 : 1;
+			}
+			if (isSmallest) { // No single step helps any more
+				break;
+			}
+		}
+	}
+	return bestLoss;
+}
+
+int Balance_LoadDifficulty(const char* path, struct Difficulty* difficulty) {
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		return 0;
+	}
+
+	char line[256];
+	while (fgets(line, sizeof(line), file) != NULL) {
+		char name[BALANCE_NAME_LENGTH];
+		int value;
+		if (sscanf(line, " %63[A-Z_] = %d", name, &value) != 2) { // Comments and blank lines
+			continue;
+		}
+		int isFound = 0;
+		for (int p = 0; p < BALANCE_PARAMETER_COUNT; ++p) {
+			if (strcmp(name, BALANCE_PARAMETERS[p].name) == 0) {
+				*Balance_GetParameter(difficulty, p) = value;
+				isFound = 1;
+			}
+		}
+		if (!isFound) {
+			printf("%s: %s is not a difficulty parameter\n", path, name);
+		}
+	}
+	fclose(file);
+	return 1;
+}
+
+int Balance_SaveDifficulty(const char* path, const struct Difficulty* difficulty) {
+	FILE* file = fopen(path, "w");
+	if (file == NULL) {
+		return 0;
+	}
+
+	struct Difficulty copy = *difficulty;
+	for (int p = 0; p < BALANCE_PARAMETER_COUNT; ++p) {
+		fprintf(file, "\t%s = %d,\n", BALANCE_PARAMETERS[p].name, *Balance_GetParameter(&copy, p));
+	}
+	return fclose(file) == 0;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[]) {
+	struct Balance_Job job = { 0 };
+	job.runCount = 1000;
+	job.seed = 1;
+	job.maxSeconds = 1200;
+	InitializeDifficulty(&job.difficulty);
+	int threadCount = Balance_CountCores();
+	const char* prefix = "balance";
+	const char* difficultyPath = NULL;
+	const char* fitPath = NULL;
+	int maxSweeps = BALANCE_FIT_SWEEPS;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "-runs") == 0) {
+			job.runCount = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-seed") == 0) {
+			job.seed = strtoull(argv[i + 1], NULL, 10);
+		} else if (strcmp(argv[i], "-threads") == 0) {
+			threadCount = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-seconds") == 0) { // Longest a run may go on for
+			job.maxSeconds = (float)atof(argv[i + 1]);
+		} else if (strcmp(argv[i], "-out") == 0) { // Prefix of the CSV files
+			prefix = argv[i + 1];
+		} else if (strcmp(argv[i], "-difficulty") == 0) { // Play with the values in a difficulty file
+			difficultyPath = argv[i + 1];
+		} else if (strcmp(argv[i], "-fit") == 0) { // Tune the difficulty to the depth histogram in a CSV file
+			fitPath = argv[i + 1];
+		} else if (strcmp(argv[i], "-sweeps") == 0) {
+			maxSweeps = atoi(argv[i + 1]);
+		}
+	}
+	threadCount = threadCount > 0 ? threadCount : 1;
+	job.runCount = job.runCount > 0 ? job.runCount : 1;
+
+	if (difficultyPath != NULL && !Balance_LoadDifficulty(difficultyPath, &job.difficulty)) {
+		printf("could not read %s\n", difficultyPath);
+		return 1;
+	}
+	if (!Balance_IsValidDifficulty(&job.difficulty)) {
+		printf("difficulty has a min above its max\n");
+		return 1;
+	}
+	float target[BALANCE_DEPTH_BUCKETS];
+	if (fitPath != NULL && !Balance_ReadDepthCsv(fitPath, target)) {
+		printf("could not read a depth histogram from %s\n", fitPath);
+		return 1;
+	}
+
+	job.runs = calloc(job.runCount, sizeof(struct Balance_Run));
+	if (job.runs == NULL) {
+		printf("not enough memory for %d runs\n", job.runCount);
+		return 1;
+	}
+
+	if (fitPath != NULL) {
+		float loss = Balance_FitDifficulty(&job, threadCount, target, maxSweeps);
+
+		// The fit only ever saw these seeds, so check it on others too
+		unsigned long long seed = job.seed;
+		job.seed = ~seed;
+		float otherLoss = Balance_GetJobLoss(&job, threadCount, target);
+		job.seed = seed;
+		printf("fitted: distance %.1f, %.1f on other seeds\n\n", loss, otherLoss);
+
+		char path[MAX_ASSET_FILEPATH];
+		snprintf(path, sizeof(path), "%s_difficulty.txt", prefix);
+		if (!Balance_SaveDifficulty(path, &job.difficulty)) {
+			printf("could not write %s\n", path);
+		}
+	}
+
+	struct timespec start, end;
+	timespec_get(&start, TIME_UTC);
+	Balance_RunAll(&job, threadCount);
+	timespec_get(&end, TIME_UTC);
+	double seconds = (double)(end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+	struct Balance_Summary summary;
+	Balance_GetSummary(job.runs, job.runCount, &summary);
+	printf("runs: %d, threads: %d, time: %.2fs, simulated: %.0fs (%.0f simulated seconds per minute)\n\n",
+		job.runCount, threadCount, seconds, summary.simulatedSeconds, seconds > 0 ? summary.simulatedSeconds / seconds * 60 : 0.0);
+	Balance_PrintSummary(job.runs, job.runCount, job.maxSeconds, &summary);
+
+	if (!Balance_WriteCsv(job.runs, job.runCount, job.maxSeconds, prefix)) {
+		printf("\ncould not write %s_*.csv\n", prefix);
+	}
+	free(job.runs);
+	return 0;
+}
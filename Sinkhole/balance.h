@@ -0,0 +1,193 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: balance.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Monte Carlo Balance Runner
+//		Added Difficulty Curve Fitting
+//
+// brief:
+// Contains the declaration of functions in balance.c.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+enum {
+	// Histograms
+	BALANCE_DEPTH_BUCKET_SIZE = 2500, // Depth covered by one bar of the depth histogram
+	BALANCE_DEPTH_BUCKETS = 40, // Deeper runs go into the last bar
+	BALANCE_SURVIVAL_STEP_SECONDS = 10, // Time between points of the survival curve
+
+	// Fitting
+	BALANCE_FIT_SWEEPS = 30, // Most passes over every parameter
+	BALANCE_NAME_LENGTH = 64, // Longest parameter name in a difficulty file
+};
+
+struct Balance_Parameter {
+	const char* name; // DIFFICULTY_* value the parameter defaults to
+	int offset; // Of the field in struct Difficulty
+	int min, max; // Values the fit may try
+	int step; // First change the fit tries, halved when nothing improves
+};
+
+struct Balance_Run {
+	unsigned long long seed;
+	float seconds; // Time survived
+	int survived; // 1 if the run was still going at the time limit
+	int depth; // maxY - 347, as shown in game
+	int kills;
+	int upgrades[MAX_UPGRADES]; // Times each upgrade was picked
+	int damageTaken[MAX_DAMAGE_SOURCES]; // Hits taken from each DAMAGE_SOURCE_*
+	int killedBy; // DAMAGE_SOURCE_* of the last hit, -1 if survived
+};
+
+struct Balance_Job {
+	struct Balance_Run* runs; // Results, one per run
+	int runCount;
+	unsigned long long seed; // Run i is seeded with seed ^ (i << 32)
+	float maxSeconds; // Runs are stopped after this long
+	struct Difficulty difficulty; // Every run is played with this
+	volatile long nextRun; // Next run for a thread to take
+};
+
+struct Balance_Summary {
+	float meanDepth, meanKills, meanSeconds;
+	int depthP10, depthP50, depthP90;
+	int survived;
+	double simulatedSeconds;
+	long upgradePicks[MAX_UPGRADES];
+	long damageTaken[MAX_DAMAGE_SOURCES];
+	long killedBy[MAX_DAMAGE_SOURCES];
+};
+
+/// <summary>
+/// Plays one run with the scripted bot until defeat or the time limit.
+/// </summary>
+/// <param name="run">Address of the Run to fill in</param>
+/// <param name="seed">Seed of the run</param>
+/// <param name="maxSeconds">Time limit in Seconds</param>
+/// <param name="difficulty">Address of the Difficulty to play with</param>
+void Balance_PlayRun(struct Balance_Run* run, unsigned long long seed, float maxSeconds, const struct Difficulty* difficulty);
+
+/// <summary>
+/// Takes runs from the job until there are none left. Run by every thread.
+/// </summary>
+/// <param name="job">Address of the Job</param>
+void Balance_Worker(struct Balance_Job* job);
+
+/// <summary>
+/// Plays every run of the job, spread over threads. Results only depend on
+/// the seed, not on the number of threads.
+/// </summary>
+/// <param name="job">Address of the Job</param>
+/// <param name="threadCount">Number of threads to use</param>
+/// <returns>1 if the runs were played, else 0</returns>
+int Balance_RunAll(struct Balance_Job* job, int threadCount);
+
+/// <summary>
+/// Sums up the results of all runs.
+/// </summary>
+/// <param name="runs">Array of Runs</param>
+/// <param name="runCount">Number of Runs</param>
+/// <param name="summary">Address of Summary to fill in</param>
+void Balance_GetSummary(const struct Balance_Run runs[], int runCount, struct Balance_Summary* summary);
+
+/// <summary>
+/// Writes prefix_runs.csv (every run), prefix_depth.csv (depth histogram)
+/// and prefix_survival.csv (share of runs still alive over time).
+/// </summary>
+/// <param name="runs">Array of Runs</param>
+/// <param name="runCount">Number of Runs</param>
+/// <param name="maxSeconds">Time limit of the runs in Seconds</param>
+/// <param name="prefix">Start of the file names</param>
+/// <returns>1 if every file was written, else 0</returns>
+int Balance_WriteCsv(const struct Balance_Run runs[], int runCount, float maxSeconds, const char* prefix);
+
+/// <summary>
+/// Gets the share of runs that were still alive after some time.
+/// </summary>
+/// <param name="runs">Array of Runs</param>
+/// <param name="runCount">Number of Runs</param>
+/// <param name="seconds">Time in Seconds</param>
+/// <returns>Share of runs from 0 to 1</returns>
+float Balance_GetAliveFraction(const struct Balance_Run runs[], int runCount, float seconds);
+
+/// <summary>
+/// Gets the name of a damage source.
+/// </summary>
+/// <param name="source">DAMAGE_SOURCE_*, or -1 for none</param>
+/// <returns>Name of the damage source</returns>
+const char* Balance_GetDamageSourceName(int source);
+
+/// <summary>
+/// Prints the summary, a depth histogram and the survival curve.
+/// </summary>
+/// <param name="runs">Array of Runs</param>
+/// <param name="runCount">Number of Runs</param>
+/// <param name="maxSeconds">Time limit of the runs in Seconds</param>
+/// <param name="summary">Address of Summary</param>
+void Balance_PrintSummary(const struct Balance_Run runs[], int runCount, float maxSeconds, const struct Balance_Summary* summary);
+
+/// <summary>
+/// Reads a depth histogram in the format of prefix_depth.csv. Only the
+/// shape matters, the runs of each bar are turned into shares of all runs.
+/// </summary>
+/// <param name="path">File to read from</param>
+/// <param name="target">Array of size BALANCE_DEPTH_BUCKETS. This will contain the output</param>
+/// <returns>1 if the file had any runs, else 0</returns>
+int Balance_ReadDepthCsv(const char* path, float target[]);
+
+/// <summary>
+/// Gets how far the depths of the runs are from a target histogram, as the
+/// area between the two cumulative histograms (earth mover's distance).
+/// It is about how much depth the average run would have to move.
+/// </summary>
+/// <param name="runs">Array of Runs</param>
+/// <param name="runCount">Number of Runs</param>
+/// <param name="target">Array of size BALANCE_DEPTH_BUCKETS, shares of runs in each bar</param>
+/// <returns>Distance in depth, 0 if they are the same</returns>
+float Balance_GetDepthLoss(const struct Balance_Run runs[], int runCount, const float target[]);
+
+/// <summary>
+/// Checks that a difficulty can be played, e.g. no random range where min is above max.
+/// </summary>
+/// <param name="difficulty">Address of the Difficulty</param>
+/// <returns>1 if it can be played, else 0</returns>
+int Balance_IsValidDifficulty(const struct Difficulty* difficulty);
+
+/// <summary>
+/// Tunes the difficulty of the job so the depths of its runs match the
+/// target histogram. Coordinate search: every parameter in turn is moved
+/// up and down by its step and kept where the runs get closer. Once a pass
+/// over every parameter finds nothing better, the steps are halved, until
+/// they are all down to 1. Every try plays the same seeds, so the only
+/// thing that changes between tries is the difficulty.
+/// </summary>
+/// <param name="job">Address of the Job, its difficulty is where the fit starts from</param>
+/// <param name="threadCount">Number of threads to use</param>
+/// <param name="target">Array of size BALANCE_DEPTH_BUCKETS, shares of runs in each bar</param>
+/// <param name="maxSweeps">Most passes over every parameter</param>
+/// <returns>Distance of the fitted difficulty from the target</returns>
+float Balance_FitDifficulty(struct Balance_Job* job, int threadCount, const float target[], int maxSweeps);
+
+/// <summary>
+/// Reads a difficulty file, lines of "DIFFICULTY_* = value". Values not in
+/// the file are left as they are.
+/// </summary>
+/// <param name="path">File to read from</param>
+/// <param name="difficulty">Address of the Difficulty to fill in</param>
+/// <returns>1 if the file was read, else 0</returns>
+int Balance_LoadDifficulty(const char* path, struct Difficulty* difficulty);
+
+/// <summary>
+/// Writes a difficulty as DIFFICULTY_* enum lines, ready to paste into
+/// initialize.h or load again with -difficulty.
+/// </summary>
+/// <param name="path">File to write to</param>
+/// <param name="difficulty">Address of the Difficulty</param>
+/// <returns>1 if the file was written, else 0</returns>
+int Balance_SaveDifficulty(const char* path, const struct Difficulty* difficulty);
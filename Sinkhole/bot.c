@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------------
+// file: bot.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Scripted Bot (moved out of headless.c)
+//		Changed enemies to be aimed at from the slots in use of their Pool
+//
+// brief:
+// A scripted player for runs without a window. Fills in the same input
+// the front end would, from nothing but the world.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#include <math.h>
+#include <string.h>
+#include "initialize.h"
+#include "platforms.h"
+#include "pool.h"
+#include "bot.h"
+
+void BotInput(struct GameWorld* world, struct Sim_Input* input) {
+	memset(input, 0, sizeof(*input));
+
+	if (world->gameState == GAME_STATE_UPGRADE) {
+		if (!world->gameStateUpgrade.isUpgradeChosen && world->gameStateUpgrade.secondsSinceState > 1.5f) {
+			input->mouseX = WINDOW_WIDTH * (0.25f + 0.25f * (world->player.totalUpgrades % 3));
+			input->mouseY = world->maxY;
+			input->leftMouseClick = 1;
+		}
+		return;
+	}
+
+	#pragma region movement
+
+	// Closest row of platforms below the player
+	const struct Platform* below = NULL;
+	for (int i = 0; i < world->platformCount; ++i) {
+		const struct Platform* row = GetPlatformRow(world, i);
+		if (row->y * 100 > world->player.y && (below == NULL || row->y < below->y)) {
+			below = row;
+		}
+	}
+
+	float targetX = world->player.x;
+	if (below != NULL) {
+		float leftWall = world->wallWidth;
+		float rightWall = WINDOW_WIDTH - world->wallWidth;
+		float edges[2 + 2 * MAX_PLATFORM_SEGMENTS] = { leftWall };
+		int edgeCount = 1;
+		for (int i = 0; i < below->segmentCount; ++i) {
+			edges[edgeCount++] = below->left[i];
+			edges[edgeCount++] = below->right[i];
+		}
+		edges[edgeCount++] = rightWall;
+
+		float closest = (float)WINDOW_WIDTH;
+		for (int i = 0; i + 1 < edgeCount; i += 2) { // Even edges open a gap, odd edges close it
+			if (edges[i + 1] - edges[i] > world->player.width) {
+				float gapCenter = (edges[i] + edges[i + 1]) / 2.0f;
+				if (fabsf(gapCenter - world->player.x) < closest) {
+					closest = fabsf(gapCenter - world->player.x);
+					targetX = gapCenter;
+				}
+			}
+		}
+	}
+
+	input->dKeyPressed = targetX > world->player.x + 10.0f;
+	input->aKeyPressed = targetX < world->player.x - 10.0f;
+
+	#pragma endregion
+
+	#pragma region shooting
+
+	float closestDistance = -1;
+	for (int i = PoolNext(&world->flyingEnemyPool, -1); i >= 0; i = PoolNext(&world->flyingEnemyPool, i)) {
+		float distance = fabsf(world->flyingEnemies[i].x - world->player.x) + fabsf(world->flyingEnemies[i].y - world->player.y);
+		if (closestDistance < 0 || distance < closestDistance) {
+			closestDistance = distance;
+			input->mouseX = world->flyingEnemies[i].x;
+			input->mouseY = world->flyingEnemies[i].y;
+		}
+	}
+	const struct Walking_Enemies* walking = &world->walkingEnemies;
+	for (int i = PoolsNext(walking->pools, world->walkingEnemyCap, -1); i >= 0; i = PoolsNext(walking->pools, world->walkingEnemyCap, i)) {
+		float distance = fabsf(walking->x[i] - world->player.x) + fabsf(walking->y[i] - world->player.y);
+		if (closestDistance < 0 || distance < closestDistance) {
+			closestDistance = distance;
+			input->mouseX = walking->x[i];
+			input->mouseY = walking->y[i];
+		}
+	}
+	input->leftMouseHold = closestDistance >= 0;
+
+	#pragma endregion
+}
@@ -0,0 +1,24 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: bot.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Scripted Bot (moved out of headless.c)
+//
+// brief:
+// Contains the declaration of functions in bot.c.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+/// <summary>
+/// Scripted player. Walks towards the closest gap of the platform below,
+/// shoots the closest enemy and picks upgrades in rotation.
+/// </summary>
+/// <param name="world">Address of Game World</param>
+/// <param name="input">Address of Input to fill in</param>
+void BotInput(struct GameWorld* world, struct Sim_Input* input);
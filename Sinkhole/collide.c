@@ -0,0 +1,244 @@
+//------------------------------------------------------------------------------------
+// file: collide.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Batched Collision Tests
+//
+// brief:
+// Tests 8 shapes at a time with AVX, 4 with SSE2, and the shapes left over
+// (or all of them without either) one at a time with the functions in utils.c.
+// The lanes do the same float operations in the same order as those functions
+// (halving is the same as dividing by 2, the square roots are rounded the same
+// way), and work out every case of a test and blend in the one that applies.
+// Distances are still compared after the square root: comparing the squares
+// gives a different answer right at the edge, and runs would no longer replay.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#ifdef _MSC_VER
+#include <intrin.h> // For _BitScanForward and _BitScanReverse
+#endif
+#include "collide.h"
+#include "utils.h"
+
+#if defined(__AVX__)
+#define COLLIDE_SIMD 1
+#define COLLIDE_LANES 8 // Shapes tested by one instruction
+#include <immintrin.h>
+typedef __m256 Collide_Vector;
+static Collide_Vector CollideLoad(const float* values) { return _mm256_loadu_ps(values); }
+static Collide_Vector CollideSet(float value) { return _mm256_set1_ps(value); }
+static Collide_Vector CollideAdd(Collide_Vector a, Collide_Vector b) { return _mm256_add_ps(a, b); }
+static Collide_Vector CollideSub(Collide_Vector a, Collide_Vector b) { return _mm256_sub_ps(a, b); }
+static Collide_Vector CollideMul(Collide_Vector a, Collide_Vector b) { return _mm256_mul_ps(a, b); }
+static Collide_Vector CollideSqrt(Collide_Vector a) { return _mm256_sqrt_ps(a); }
+static Collide_Vector CollideLess(Collide_Vector a, Collide_Vector b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+static Collide_Vector CollideAnd(Collide_Vector a, Collide_Vector b) { return _mm256_and_ps(a, b); }
+static Collide_Vector CollideOr(Collide_Vector a, Collide_Vector b) { return _mm256_or_ps(a, b); }
+static Collide_Vector CollideNot(Collide_Vector a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+static Collide_Vector CollideSelect(Collide_Vector mask, Collide_Vector a, Collide_Vector b) { return _mm256_blendv_ps(b, a, mask); }
+static unsigned int CollideBits(Collide_Vector mask) { return (unsigned int)_mm256_movemask_ps(mask); }
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLIDE_SIMD 1
+#define COLLIDE_LANES 4
+#include <emmintrin.h>
+typedef __m128 Collide_Vector;
+static Collide_Vector CollideLoad(const float* values) { return _mm_loadu_ps(values); }
+static Collide_Vector CollideSet(float value) { return _mm_set1_ps(value); }
+static Collide_Vector CollideAdd(Collide_Vector a, Collide_Vector b) { return _mm_add_ps(a, b); }
+static Collide_Vector CollideSub(Collide_Vector a, Collide_Vector b) { return _mm_sub_ps(a, b); }
+static Collide_Vector CollideMul(Collide_Vector a, Collide_Vector b) { return _mm_mul_ps(a, b); }
+static Collide_Vector CollideSqrt(Collide_Vector a) { return _mm_sqrt_ps(a); }
+static Collide_Vector CollideLess(Collide_Vector a, Collide_Vector b) { return _mm_cmplt_ps(a, b); }
+static Collide_Vector CollideAnd(Collide_Vector a, Collide_Vector b) { return _mm_and_ps(a, b); }
+static Collide_Vector CollideOr(Collide_Vector a, Collide_Vector b) { return _mm_or_ps(a, b); }
+static Collide_Vector CollideNot(Collide_Vector a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+static Collide_Vector CollideSelect(Collide_Vector mask, Collide_Vector a, Collide_Vector b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+static unsigned int CollideBits(Collide_Vector mask) { return (unsigned int)_mm_movemask_ps(mask); }
+#endif
+
+#ifdef COLLIDE_SIMD
+
+#pragma region kernels
+
+// IsCircleClicked
+static Collide_Vector CollidePoint(Collide_Vector x, Collide_Vector y, Collide_Vector radius, Collide_Vector pointX, Collide_Vector pointY) {
+	Collide_Vector dx = CollideSub(x, pointX);
+	Collide_Vector dy = CollideSub(y, pointY);
+	return CollideLess(CollideSqrt(CollideAdd(CollideMul(dx, dx), CollideMul(dy, dy))), radius);
+}
+
+// AreCirclesIntersecting
+static Collide_Vector CollideCircles(Collide_Vector x1, Collide_Vector y1, Collide_Vector r1, Collide_Vector x2, Collide_Vector y2, Collide_Vector r2) {
+	Collide_Vector dx = CollideSub(x1, x2);
+	Collide_Vector dy = CollideSub(y1, y2);
+	return CollideLess(CollideSqrt(CollideAdd(CollideMul(dx, dx), CollideMul(dy, dy))), CollideAdd(r1, r2));
+}
+
+// IsCircleAndEdgesIntersecting
+static Collide_Vector CollideCircleEdges(Collide_Vector x, Collide_Vector y, Collide_Vector diameter, Collide_Vector left, Collide_Vector top, Collide_Vector right, Collide_Vector bottom) {
+	Collide_Vector radius = CollideMul(diameter, CollideSet(0.5f));
+	Collide_Vector leftCircle = CollideSub(x, radius);
+	Collide_Vector rightCircle = CollideAdd(x, radius);
+	Collide_Vector topCircle = CollideSub(y, radius);
+	Collide_Vector bottomCircle = CollideAdd(y, radius);
+
+	// CASE 1: Circle center inside the rect on X or Y
+	Collide_Vector isXInside = CollideAnd(CollideLess(left, x), CollideLess(x, right));
+	Collide_Vector isYInside = CollideAnd(CollideLess(top, y), CollideLess(y, bottom));
+	Collide_Vector isXHit = CollideNot(CollideOr(CollideLess(bottomCircle, top), CollideLess(bottom, topCircle)));
+	Collide_Vector isYHit = CollideNot(CollideOr(CollideLess(rightCircle, left), CollideLess(right, leftCircle)));
+
+	// CASE 2: A corner of the rect inside the circle
+	Collide_Vector isCornerHit = CollideOr(
+		CollideOr(CollidePoint(x, y, radius, left, top), CollidePoint(x, y, radius, right, top)),
+		CollideOr(CollidePoint(x, y, radius, left, bottom), CollidePoint(x, y, radius, right, bottom)));
+
+	return CollideSelect(isXInside, isXHit, CollideSelect(isYInside, isYHit, isCornerHit));
+}
+
+// IsCircleAndRectIntersecting
+static Collide_Vector CollideCircleRect(Collide_Vector x, Collide_Vector y, Collide_Vector diameter, Collide_Vector rectX, Collide_Vector rectY, Collide_Vector width, Collide_Vector height) {
+	Collide_Vector half = CollideSet(0.5f);
+	Collide_Vector halfWidth = CollideMul(width, half);
+	Collide_Vector halfHeight = CollideMul(height, half);
+	return CollideCircleEdges(x, y, diameter, CollideSub(rectX, halfWidth), CollideSub(rectY, halfHeight), CollideAdd(rectX, halfWidth), CollideAdd(rectY, halfHeight));
+}
+
+// AreRectanglesIntersecting
+static Collide_Vector CollideRects(Collide_Vector x1, Collide_Vector y1, Collide_Vector width1, Collide_Vector height1, Collide_Vector x2, Collide_Vector y2, Collide_Vector width2, Collide_Vector height2) {
+	Collide_Vector half = CollideSet(0.5f);
+	Collide_Vector left1 = CollideSub(x1, CollideMul(width1, half));
+	Collide_Vector right1 = CollideAdd(x1, CollideMul(width1, half));
+	Collide_Vector top1 = CollideSub(y1, CollideMul(height1, half));
+	Collide_Vector bottom1 = CollideAdd(y1, CollideMul(height1, half));
+	Collide_Vector left2 = CollideSub(x2, CollideMul(width2, half));
+	Collide_Vector right2 = CollideAdd(x2, CollideMul(width2, half));
+	Collide_Vector top2 = CollideSub(y2, CollideMul(height2, half));
+	Collide_Vector bottom2 = CollideAdd(y2, CollideMul(height2, half));
+	Collide_Vector isApartX = CollideOr(CollideLess(right2, left1), CollideLess(right1, left2));
+	Collide_Vector isApartY = CollideOr(CollideLess(bottom2, top1), CollideLess(bottom1, top2));
+	return CollideNot(CollideOr(isApartX, isApartY));
+}
+
+#pragma endregion
+
+#endif
+
+int CollideCount(unsigned int bits) {
+	if (!bits) {
+		return 0;
+	}
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse(&index, bits);
+	return (int)index + 1;
+#else
+	return 32 - __builtin_clz(bits);
+#endif
+}
+
+int CollideFirst(unsigned int hits) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, hits);
+	return (int)index;
+#else
+	return __builtin_ctz(hits);
+#endif
+}
+
+unsigned int CircleHitsPoints(float x, float y, float diameter, const float xs[], const float ys[], int count) {
+	unsigned int hits = 0;
+	int k = 0;
+#ifdef COLLIDE_SIMD
+	Collide_Vector circleX = CollideSet(x), circleY = CollideSet(y), radius = CollideSet(diameter / 2.0f);
+	for (; k + COLLIDE_LANES <= count; k += COLLIDE_LANES) {
+		hits |= CollideBits(CollidePoint(circleX, circleY, radius, CollideLoad(&xs[k]), CollideLoad(&ys[k]))) << k;
+	}
+#endif
+	for (; k < count; ++k) { // The rest one at a time
+		hits |= (unsigned int)IsCircleClicked(x, y, diameter, xs[k], ys[k]) << k;
+	}
+	return hits;
+}
+
+unsigned int CircleHitsCircles(float x, float y, float radius, const float xs[], const float ys[], const float radii[], int count) {
+	unsigned int hits = 0;
+	int k = 0;
+#ifdef COLLIDE_SIMD
+	Collide_Vector circleX = CollideSet(x), circleY = CollideSet(y), circleRadius = CollideSet(radius);
+	for (; k + COLLIDE_LANES <= count; k += COLLIDE_LANES) {
+		hits |= CollideBits(CollideCircles(circleX, circleY, circleRadius, CollideLoad(&xs[k]), CollideLoad(&ys[k]), CollideLoad(&radii[k]))) << k;
+	}
+#endif
+	for (; k < count; ++k) {
+		hits |= (unsigned int)AreCirclesIntersecting(x, y, radius, xs[k], ys[k], radii[k]) << k;
+	}
+	return hits;
+}
+
+unsigned int CircleHitsRects(float x, float y, float diameter, const float rectX[], const float rectY[], const float widths[], const float heights[], int count) {
+	unsigned int hits = 0;
+	int k = 0;
+#ifdef COLLIDE_SIMD
+	Collide_Vector circleX = CollideSet(x), circleY = CollideSet(y), circleDiameter = CollideSet(diameter);
+	for (; k + COLLIDE_LANES <= count; k += COLLIDE_LANES) {
+		hits |= CollideBits(CollideCircleRect(circleX, circleY, circleDiameter, CollideLoad(&rectX[k]), CollideLoad(&rectY[k]), CollideLoad(&widths[k]), CollideLoad(&heights[k]))) << k;
+	}
+#endif
+	for (; k < count; ++k) {
+		hits |= (unsigned int)IsCircleAndRectIntersecting(x, y, diameter, rectX[k], rectY[k], widths[k], heights[k]) << k;
+	}
+	return hits;
+}
+
+unsigned int CirclesHitRect(const float xs[], const float ys[], const float diameters[], float rectX, float rectY, float width, float height, int count) {
+	unsigned int hits = 0;
+	int k = 0;
+#ifdef COLLIDE_SIMD
+	Collide_Vector x = CollideSet(rectX), y = CollideSet(rectY), rectWidth = CollideSet(width), rectHeight = CollideSet(height);
+	for (; k + COLLIDE_LANES <= count; k += COLLIDE_LANES) {
+		hits |= CollideBits(CollideCircleRect(CollideLoad(&xs[k]), CollideLoad(&ys[k]), CollideLoad(&diameters[k]), x, y, rectWidth, rectHeight)) << k;
+	}
+#endif
+	for (; k < count; ++k) {
+		hits |= (unsigned int)IsCircleAndRectIntersecting(xs[k], ys[k], diameters[k], rectX, rectY, width, height) << k;
+	}
+	return hits;
+}
+
+unsigned int CircleHitsSegments(float x, float y, float diameter, const float left[], const float right[], float top, float bottom, int count) {
+	unsigned int hits = 0;
+	int k = 0;
+#ifdef COLLIDE_SIMD
+	Collide_Vector circleX = CollideSet(x), circleY = CollideSet(y), circleDiameter = CollideSet(diameter), rowTop = CollideSet(top), rowBottom = CollideSet(bottom);
+	for (; k + COLLIDE_LANES <= count; k += COLLIDE_LANES) {
+		hits |= CollideBits(CollideCircleEdges(circleX, circleY, circleDiameter, CollideLoad(&left[k]), rowTop, CollideLoad(&right[k]), rowBottom)) << k;
+	}
+#endif
+	for (; k < count; ++k) {
+		hits |= (unsigned int)IsCircleAndEdgesIntersecting(x, y, diameter, left[k], top, right[k], bottom) << k;
+	}
+	return hits;
+}
+
+unsigned int RectHitsRects(float x, float y, float width, float height, const float xs[], const float ys[], const float widths[], const float heights[], int count) {
+	unsigned int hits = 0;
+	int k = 0;
+#ifdef COLLIDE_SIMD
+	Collide_Vector rectX = CollideSet(x), rectY = CollideSet(y), rectWidth = CollideSet(width), rectHeight = CollideSet(height);
+	for (; k + COLLIDE_LANES <= count; k += COLLIDE_LANES) {
+		hits |= CollideBits(CollideRects(rectX, rectY, rectWidth, rectHeight, CollideLoad(&xs[k]), CollideLoad(&ys[k]), CollideLoad(&widths[k]), CollideLoad(&heights[k]))) << k;
+	}
+#endif
+	for (; k < count; ++k) {
+		hits |= (unsigned int)AreRectanglesIntersecting(x, y, width, height, xs[k], ys[k], widths[k], heights[k]) << k;
+	}
+	return hits;
+}
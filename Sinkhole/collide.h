@@ -0,0 +1,120 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: collide.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Batched Collision Tests
+//
+// brief:
+// Contains the declaration of functions in collide.c.
+// Tests one shape against arrays of shapes (one array per value) and returns
+// a bit per shape that is hit, bit k for shape k. Each function gives the
+// same result, to the bit, as calling its function in utils.c on every shape,
+// which headless.c -collide checks.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+enum {
+	COLLIDE_BATCH = 32, // Most shapes tested by one call, one bit each
+};
+
+/// <summary>
+/// IsCircleClicked for every point.
+/// </summary>
+/// <param name="x">circle center x</param>
+/// <param name="y">circle center y</param>
+/// <param name="diameter">circle diameter</param>
+/// <param name="xs">point x values</param>
+/// <param name="ys">point y values</param>
+/// <param name="count">Number of points, up to COLLIDE_BATCH</param>
+/// <returns>Bit k set if point k is inside the circle</returns>
+unsigned int CircleHitsPoints(float x, float y, float diameter, const float xs[], const float ys[], int count);
+
+/// <summary>
+/// AreCirclesIntersecting for every circle.
+/// </summary>
+/// <param name="x">circle center x</param>
+/// <param name="y">circle center y</param>
+/// <param name="radius">circle radius</param>
+/// <param name="xs">circle center x values</param>
+/// <param name="ys">circle center y values</param>
+/// <param name="radii">circle radii</param>
+/// <param name="count">Number of circles, up to COLLIDE_BATCH</param>
+/// <returns>Bit k set if circle k intersects the circle</returns>
+unsigned int CircleHitsCircles(float x, float y, float radius, const float xs[], const float ys[], const float radii[], int count);
+
+/// <summary>
+/// IsCircleAndRectIntersecting for every rect.
+/// </summary>
+/// <param name="x">circle center x</param>
+/// <param name="y">circle center y</param>
+/// <param name="diameter">circle diameter</param>
+/// <param name="rectX">rect center x values</param>
+/// <param name="rectY">rect center y values</param>
+/// <param name="widths">rect widths</param>
+/// <param name="heights">rect heights</param>
+/// <param name="count">Number of rects, up to COLLIDE_BATCH</param>
+/// <returns>Bit k set if rect k intersects the circle</returns>
+unsigned int CircleHitsRects(float x, float y, float diameter, const float rectX[], const float rectY[], const float widths[], const float heights[], int count);
+
+/// <summary>
+/// IsCircleAndRectIntersecting for every circle.
+/// </summary>
+/// <param name="xs">circle center x values</param>
+/// <param name="ys">circle center y values</param>
+/// <param name="diameters">circle diameters</param>
+/// <param name="rectX">rect center x</param>
+/// <param name="rectY">rect center y</param>
+/// <param name="width">rect width</param>
+/// <param name="height">rect height</param>
+/// <param name="count">Number of circles, up to COLLIDE_BATCH</param>
+/// <returns>Bit k set if circle k intersects the rect</returns>
+unsigned int CirclesHitRect(const float xs[], const float ys[], const float diameters[], float rectX, float rectY, float width, float height, int count);
+
+/// <summary>
+/// IsCircleAndEdgesIntersecting for every segment of a row (rects sharing their top and bottom).
+/// </summary>
+/// <param name="x">circle center x</param>
+/// <param name="y">circle center y</param>
+/// <param name="diameter">circle diameter</param>
+/// <param name="left">segment left edges</param>
+/// <param name="right">segment right edges</param>
+/// <param name="top">top edge of the row</param>
+/// <param name="bottom">bottom edge of the row</param>
+/// <param name="count">Number of segments, up to COLLIDE_BATCH</param>
+/// <returns>Bit k set if segment k intersects the circle</returns>
+unsigned int CircleHitsSegments(float x, float y, float diameter, const float left[], const float right[], float top, float bottom, int count);
+
+/// <summary>
+/// AreRectanglesIntersecting for every rect.
+/// </summary>
+/// <param name="x">rect center x</param>
+/// <param name="y">rect center y</param>
+/// <param name="width">rect width</param>
+/// <param name="height">rect height</param>
+/// <param name="xs">rect center x values</param>
+/// <param name="ys">rect center y values</param>
+/// <param name="widths">rect widths</param>
+/// <param name="heights">rect heights</param>
+/// <param name="count">Number of rects, up to COLLIDE_BATCH</param>
+/// <returns>Bit k set if rect k intersects the rect</returns>
+unsigned int RectHitsRects(float x, float y, float width, float height, const float xs[], const float ys[], const float widths[], const float heights[], int count);
+
+/// <summary>
+/// Gets how many shapes have to be tested for every set bit to be in a batch.
+/// </summary>
+/// <param name="bits">Bit k set for shape k</param>
+/// <returns>Highest set bit + 1, 0 if no bit is set</returns>
+int CollideCount(unsigned int bits);
+
+/// <summary>
+/// Gets the first shape hit.
+/// </summary>
+/// <param name="hits">Bits returned by a test, must not be 0</param>
+/// <returns>Lowest set bit</returns>
+int CollideFirst(unsigned int hits);
@@ -5,6 +5,8 @@
 // l.zheneudamon (primary author)
 //		Added Click to Speed up Credits
 //		Added Content of Credits
+//		Changed fonts to come from the Asset Registry
+//		Changed images and music to be kept across scenes by the Asset Registry
 // timo.duethorn
 //		Added Drawing of Background
 //		Added Music
@@ -20,6 +22,7 @@
 
 #include <stdio.h>
 #include "cprocessing.h"
+#include "assets.h"
 #include "mainmenu.h"
 
 CP_Image backgroundImage, copyrightImage;
@@ -45,11 +48,11 @@ float backgroundHeight2;
 float ascendedDistance;
 
 void Credits_Init(void) {
-	backgroundImage = CP_Image_Load("Assets/Images/Background/background.png");
-	copyrightImage = CP_Image_Load("Assets/Images/Others/copyright.png");
-	creditsTrack = CP_Sound_LoadMusic("Assets/Music/ancient_ruins.mp3");
-	titleFont = CP_Font_Load("Assets/Fonts/RussoOne-Regular.ttf");
-	textFont = CP_Font_Load("Assets/Fonts/Alice-Regular.ttf");
+	backgroundImage = Assets_LoadImage("Assets/Images/Background/background.png");
+	copyrightImage = Assets_LoadImage("Assets/Images/Others/copyright.png");
+	creditsTrack = Assets_LoadMusic("Assets/Music/ancient_ruins.mp3");
+	titleFont = Assets_GetFont(Assets_LoadFont("Assets/Fonts/RussoOne-Regular.ttf"));
+	textFont = Assets_GetFont(Assets_LoadFont("Assets/Fonts/Alice-Regular.ttf"));
 
 	leftMouseDown = 0;
 	playMusicOnce = 0;
@@ -184,7 +187,7 @@ void Credits_Update(void) {
 }
 
 void Credits_Exit(void) {
-	CP_Image_Free(&backgroundImage);
-	CP_Image_Free(&copyrightImage);
-	CP_Sound_Free(&creditsTrack);
+	Assets_ReleaseImage(&backgroundImage);
+	Assets_ReleaseImage(&copyrightImage);
+	Assets_ReleaseSound(&creditsTrack);
 }
@@ -22,17 +22,11 @@
 /// <summary>
 /// Spawns Enemies on Platform based on player's Progression.
 /// </summary>
-/// <param name="playerTotalUpgrades"> Total Number of Player Upgardes </param>
-/// <param name="walkingEnemies"> Array of Walking Enemies </param>
-/// <param name="platforms"> Array of Platforms </param>
-void DifficultyPlatformModifier(int playerTotalUpgrades, struct Walking_Enemy walkingEnemies[], struct Platform platforms[]);
+/// <param name="world"> Address of Game World </param>
+void DifficultyPlatformModifier(struct GameWorld* world);
 
 /// <summary>
 /// Spawns Flying Enemies and Hazards based on player's Progression.
 /// </summary>
-/// <param name="playerTotalUpgrades"> Total Number of Player Upgardes </param>
-/// <param name="flyingEnemies"> Array of Flying Enemies </param>
-/// <param name="maxY"> Max Y Value </param>
-/// <param name="gameTimer"> Game Timer </param>
-/// <param name="lastSpawnedTime"> Time since last Spawn </param>
-void DifficultyModifier(int playerTotalUpgrades, struct Flying_Enemy flyingEnemies[], struct Lazer_Hazard lazerHazard[], float maxY, float gameTimer, float* lastSpawnedTime, float* lazerSpawnedTimer, int* nextLazerTimer);
+/// <param name="world"> Address of Game World </param>
+void DifficultyModifier(struct GameWorld* world);
@@ -6,6 +6,13 @@
 //		Added all functions regarding flying enemies
 // l.kangweimatthew 
 //		Added all functions regarding walking enemies 
+// l.zheneudamon
+//		Changed walking enemies to spawn on the platform segments of the bottom row
+//		Changed enemies to spawn from and go through their Pools
+//		Changed walking enemies to a structure of arrays, moved several at a time with SIMD
+//		Added a raised walking enemy cap for stress testing
+//		Changed bullets to only test the walking enemies near them, found through a Grid
+//		Changed hit tests to go through the batched tests in collide.c
 //
 // brief:
 // Contains the function definitions for spawning flying and walking enemies and their respective behaviour logic 
@@ -19,37 +26,50 @@
 #include <math.h>
 #include <stdio.h>
 #include "initialize.h"
-#include "cprocessing.h"
 #include "utils.h"
 #include "pickups.h"
+#include "platforms.h"
+#include "pool.h"
+#include "grid.h"
+#include "collide.h"
+
+#if defined(__AVX__)
+#define WALKING_ENEMY_LANES 8 // Walking enemies moved by one instruction
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WALKING_ENEMY_SSE 1
+#define WALKING_ENEMY_LANES 4
+#include <emmintrin.h>
+#else
+#define WALKING_ENEMY_LANES 4
+#endif
 
 #pragma region FlyingEnemies
 
-void ContinuousSpawningFlying(struct Flying_Enemy enemies[], int enemyCount, float maxY, int healthModifier, int speedModifier) {
-	int count = 0;
-	for (int i = 0; i < MAX_FLYING_ENEMIES; ++i) {
-		if (!enemies[i].isActive) {
-			int rng = RandomNumber(0, 100);
-			enemies[i].x = (rng / 100.0f) * CP_System_GetWindowWidth();
-			enemies[i].y = CP_System_GetWindowHeight() + maxY; // Set Y-coordinate from the bottom, with spacing
-			enemies[i].enemyHealth = DIFFICULTY_MIN_FLYING_ENEMIES_HEALTH + healthModifier;
-			enemies[i].enemySpeed = DIFFICULTY_MIN_FLYING_ENEMIES_SPEED + speedModifier;
-			enemies[i].diameter = CP_System_GetWindowWidth() * 0.03f;
-			enemies[i].isActive = 1;
-			count++;
-		}
-
-		if (enemyCount <= count) {
+void ContinuousSpawningFlying(struct GameWorld* world, int enemyCount, int healthModifier, int speedModifier) {
+	struct Flying_Enemy* enemies = world->flyingEnemies;
+	for (int count = 0; count < enemyCount; ++count) {
+		int i = PoolSpawn(&world->flyingEnemyPool, MAX_FLYING_ENEMIES); // Lowest inactive enemy
+		if (i < 0) {
 			break;
 		}
+		int rng = RandomNumber(&world->rng[RNG_STREAM_ENEMIES], 0, 100);
+		enemies[i].x = (rng / 100.0f) * WINDOW_WIDTH;
+		enemies[i].y = WINDOW_HEIGHT + world->maxY; // Set Y-coordinate from the bottom, with spacing
+		enemies[i].enemyHealth = world->difficulty.minFlyingEnemiesHealth + healthModifier;
+		enemies[i].enemySpeed = world->difficulty.minFlyingEnemiesSpeed + speedModifier;
+		enemies[i].diameter = WINDOW_WIDTH * 0.03f;
 	}
 }
 
-void UpdateFlyingEnemies(struct Player player, struct Flying_Enemy enemies[]) {
-	for (int i = 0; i < MAX_FLYING_ENEMIES; i++) {
+void UpdateFlyingEnemies(struct GameWorld* world, float dt) {
+	struct Entity_Pool* pool = &world->flyingEnemyPool;
+	struct Flying_Enemy* enemies = world->flyingEnemies;
+	struct Player* player = &world->player;
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
 		// Update enemy movements based on the player's position
-		float dx = player.x - enemies[i].x; // Calculate the X distance to the player
-		float dy = player.y - enemies[i].y; // Calculate the Y distance to the player
+		float dx = player->x - enemies[i].x; // Calculate the X distance to the player
+		float dy = player->y - enemies[i].y; // Calculate the Y distance to the player
 
 		float distance_to_player = sqrtf(dx * dx + dy * dy); // Calculate the distance
 
@@ -59,55 +79,98 @@ void UpdateFlyingEnemies(struct Player player, struct Flying_Enemy enemies[]) {
 			float dir_y = dy / distance_to_player;
 
 			// Update the enemy's position to move toward the player
-			enemies[i].x += dir_x * enemies[i].enemySpeed;
-			enemies[i].y += dir_y * enemies[i].enemySpeed;
+			enemies[i].x += dir_x * enemies[i].enemySpeed * ENEMY_SPEED_FRAME_RATE * dt;
+			enemies[i].y += dir_y * enemies[i].enemySpeed * ENEMY_SPEED_FRAME_RATE * dt;
 		}
 
 		if (enemies[i].enemyHealth < 1) {
-			enemies[i].isActive = 0;
+			PoolDespawn(pool, i);
 		}
 	}
 
 }
 
-void BulletHitFlyingEnemy(struct Bullet bullets[], struct Flying_Enemy enemies[], struct Player* player) {
-	for (int i = 0; i < MAX_BULLETS; i++) {
-		if (bullets[i].isActive) {
-			for (int j = 0; j < MAX_FLYING_ENEMIES; j++) {
-				if (enemies[j].isActive) {
-					// Check for collision between the bullet and the enemy.
-					if (AreCirclesIntersecting(bullets[i].x, bullets[i].y, bullets[i].diameterSize, enemies[j].x, enemies[j].y, enemies[j].diameter)) {
-						bullets[i].isActive = 0; // Deactivate the bullet.
-						enemies[j].enemyHealth -= player->damage;
-						if (enemies[j].enemyHealth <= 0) {
-							player->killCount += 1;
-							enemies[j].isActive = 0; // Deactivate the enemy.
-						}
-						break;
-					}
-				}
+// Lowest flying enemy slot in use the bullet hits, going through every slot in order. -1 if none
+int FirstFlyingEnemyHit(const struct Bullet* bullet, const float xs[], const float ys[], const float radii[], const struct Entity_Pool* pool) {
+	for (int first = 0; first < MAX_FLYING_ENEMIES; first += COLLIDE_BATCH) {
+		unsigned int live = PoolsBits(pool, first, MAX_FLYING_ENEMIES - first < COLLIDE_BATCH ? MAX_FLYING_ENEMIES - first : COLLIDE_BATCH);
+		unsigned int hits = live ? CircleHitsCircles(bullet->x, bullet->y, bullet->diameterSize, &xs[first], &ys[first], &radii[first], CollideCount(live)) & live : 0;
+		if (hits) {
+			return first + CollideFirst(hits);
+		}
+	}
+	return -1;
+}
+
+void BulletHitFlyingEnemy(struct GameWorld* world) {
+	struct Entity_Pool* bulletPool = &world->bulletPool;
+	struct Entity_Pool* enemyPool = &world->flyingEnemyPool;
+	struct Bullet* bullets = world->bullets;
+	struct Flying_Enemy* enemies = world->flyingEnemies;
+	struct Player* player = &world->player;
+	if (PoolNext(bulletPool, -1) < 0) {
+		return;
+	}
+	// One array per value for the batched tests, enemies do not move while bullets hit them
+	float xs[MAX_FLYING_ENEMIES], ys[MAX_FLYING_ENEMIES], radii[MAX_FLYING_ENEMIES];
+	for (int j = 0; j < MAX_FLYING_ENEMIES; ++j) {
+		xs[j] = enemies[j].x;
+		ys[j] = enemies[j].y;
+		radii[j] = enemies[j].diameter; // AreCirclesIntersecting takes the diameters as the radii
+	}
+
+	// No grid, MAX_FLYING_ENEMIES is below GRID_MIN_ENTITIES and one batched test covers every slot
+	for (int i = PoolNext(bulletPool, -1); i >= 0; i = PoolNext(bulletPool, i)) {
+		// Check for collision between the bullet and the enemies.
+		int hit = FirstFlyingEnemyHit(&bullets[i], xs, ys, radii, enemyPool);
+		if (hit >= 0) {
+			PoolDespawn(bulletPool, i); // Deactivate the bullet.
+			enemies[hit].enemyHealth -= player->damage;
+			if (enemies[hit].enemyHealth <= 0) {
+				player->killCount += 1;
+				PoolDespawn(enemyPool, hit); // Deactivate the enemy.
 			}
 		}
 	}
 }
 
-void FlyingEnemyTouchPlayer(struct Flying_Enemy enemies[], struct Player* player) {
-	for (int i = 0; i < MAX_FLYING_ENEMIES; i++) {
-		if (enemies[i].isActive) {
-			// Check for collision between the bullet and the enemy.
-			if (IsCircleAndRectIntersecting(enemies[i].x, enemies[i].y, enemies[i].diameter, player->x, player->y, player->width, player->height)) {
+int FlyingEnemyTouchPlayer(struct GameWorld* world) {
+	struct Entity_Pool* pool = &world->flyingEnemyPool;
+	struct Flying_Enemy* enemies = world->flyingEnemies;
+	struct Player* player = &world->player;
+	int hits = 0;
+	for (int first = 0; first < MAX_FLYING_ENEMIES; first += COLLIDE_BATCH) {
+		int count = MAX_FLYING_ENEMIES - first < COLLIDE_BATCH ? MAX_FLYING_ENEMIES - first : COLLIDE_BATCH;
+		unsigned int live = PoolsBits(pool, first, count);
+		if (!live) {
+			continue;
+		}
+		count = CollideCount(live); // Up to the last slot in use
+		float xs[COLLIDE_BATCH], ys[COLLIDE_BATCH], diameters[COLLIDE_BATCH];
+		for (int k = 0; k < count; ++k) { // Free slots are tested too, their bits are left out
+			xs[k] = enemies[first + k].x;
+			ys[k] = enemies[first + k].y;
+			diameters[k] = enemies[first + k].diameter;
+		}
+		// Check for collision between the Player and the enemies.
+		unsigned int touched = CirclesHitRect(xs, ys, diameters, player->x, player->y, player->width, player->height, count) & live;
+		for (int k = 0; touched; ++k, touched >>= 1) {
+			if (touched & 1) {
 				player->currentHealth -= 1;
-				CP_Sound_Play(player->damagedSFX);
-				enemies[i].isActive = 0;
+				PoolDespawn(pool, first + k);
+				hits++;
 			}
 		}
 	}
+	return hits;
 }
 
-void DespawnFlyingEnemy(struct Flying_Enemy enem[], float maxY) {
-	for (int i = 0; i < MAX_FLYING_ENEMIES; ++i) {
-		if (enem[i].isActive && enem[i].y < maxY - CP_System_GetWindowHeight() / 2.0f) {
-			enem[i].isActive = 0;
+void DespawnFlyingEnemy(struct GameWorld* world) {
+	struct Entity_Pool* pool = &world->flyingEnemyPool;
+	struct Flying_Enemy* enem = world->flyingEnemies;
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		if (enem[i].y < world->maxY - WINDOW_HEIGHT / 2.0f) {
+			PoolDespawn(pool, i);
 		}
 	}
 }
@@ -116,126 +179,324 @@ void DespawnFlyingEnemy(struct Flying_Enemy enem[], float maxY) {
 
 #pragma region WalkingEnemies
 
-void ContinuousSpawningWalking(struct Walking_Enemy enem[], int enemyCount, struct Platform platforms[], int healthModifier, int speedModifier) {
-	int count = 0;
-	for (int i = 0; i < MAX_WALKING_ENEMIES; ++i) { // if i is less than max enemies
-		// Do RNG
-		int rng = RandomNumber(0, 99);
-		int random = RandomNumber(1, 2);
-		int directionRNG = rng % 2; // 0 / 1
-		float platformHeight = (CP_System_GetWindowHeight() / 100.0f) / 2;
-		if (!enem[i].isActive) { // if its not active
-			// Set Data
-			enem[i].width = (int)(3 * CP_System_GetWindowWidth() / 100.0f);
-			enem[i].height = (int)(enem[i].width * 1.5f);
-			enem[i].speed = DIFFICULTY_MIN_WALKING_ENEMIES_SPEED + speedModifier;
-			enem[i].detectRange = 200;
-			enem[i].health = DIFFICULTY_MIN_WALKING_ENEMIES_HEALTH + healthModifier;
-			enem[i].dir = directionRNG;
-			// Set Position
-			if (platforms[5].p2Coord != 1600) { // if platform two does not exist
-				if (random == 1) {
-					enem[i].boundL = platforms[5].p1Coord - platforms[5].p1Length / 2.0f;
-					enem[i].boundR = platforms[5].p1Coord + platforms[5].p1Length / 2.0f;
-					enem[i].x = enem[i].boundL + rng / 100.0f * (enem[i].boundR - enem[i].boundL);
-					enem[i].y = platforms[5].y * 100 - platformHeight - enem[i].height / 2.0f;
-				} else {
-					enem[i].boundL = platforms[5].p2Coord - platforms[5].p2Length / 2.0f;
-					enem[i].boundR = platforms[5].p2Coord + platforms[5].p2Length / 2.0f;
-					enem[i].x = enem[i].boundL + rng / 100.0f * (enem[i].boundR - enem[i].boundL);
-					enem[i].y = platforms[5].y * 100 - platformHeight - enem[i].height / 2.0f;
-				}
-			} else {
-				enem[i].boundL = platforms[5].p1Coord - platforms[5].p1Length / 2.0f;
-				enem[i].boundR = platforms[5].p1Coord + platforms[5].p1Length / 2.0f;
-				enem[i].x = enem[i].boundL + rng / 100.0f * (enem[i].boundR - enem[i].boundL);
-				enem[i].y = platforms[5].y * 100 - platformHeight - enem[i].height / 2.0f;
+// Sets the values of walking enemy i, standing on a segment of the platform.
+// rng (0 to 99) picks where on the segment it stands and which way it faces
+void SetWalkingEnemy(struct GameWorld* world, int i, const struct Platform* platform, int segment, int rng, int healthModifier, int speedModifier) {
+	struct Walking_Enemies* enem = &world->walkingEnemies;
+	int directionRNG = rng % 2; // 0 / 1
+	// Set Data
+	enem->width[i] = (float)(int)(3 * WINDOW_WIDTH / 100.0f);
+	enem->height[i] = (float)(int)(enem->width[i] * 1.5f);
+	enem->speed[i] = (float)(world->difficulty.minWalkingEnemiesSpeed + speedModifier);
+	enem->detectRange[i] = 200;
+	enem->health[i] = world->difficulty.minWalkingEnemiesHealth + healthModifier;
+	enem->dir[i] = (float)directionRNG;
+	// Set Position
+	enem->boundL[i] = platform->left[segment];
+	enem->boundR[i] = platform->right[segment];
+	enem->x[i] = enem->boundL[i] + rng / 100.0f * (enem->boundR[i] - enem->boundL[i]);
+	enem->y[i] = platform->top - enem->height[i] / 2.0f;
+}
+
+void ContinuousSpawningWalking(struct GameWorld* world, int enemyCount, int healthModifier, int speedModifier) {
+	const struct Platform* platform = GetPlatformRow(world, PLATFORM_WINDOW_ROWS - 1); // Bottom row around the player
+	if (platform->segmentCount == 0) { // Nothing to stand on in an empty row
+		return;
+	}
+	for (int count = 0; count < enemyCount; ++count) { // until spawn count reaches set count
+		int i = PoolsSpawn(world->walkingEnemies.pools, world->walkingEnemyCap); // Lowest inactive enemy
+		if (i < 0) {
+			break;
+		}
+		// RNG was rolled when the row was built, one slot per enemy
+		SetWalkingEnemy(world, i, platform, platform->spawnSegment[count], platform->spawnX[count], healthModifier, speedModifier);
+	}
+}
+
+void StressSpawningWalking(struct GameWorld* world) {
+	const struct Platform* segmentRows[PLATFORM_WINDOW_ROWS * MAX_PLATFORM_SEGMENTS];
+	int segments[PLATFORM_WINDOW_ROWS * MAX_PLATFORM_SEGMENTS];
+	int segmentCount = 0;
+	for (int j = 0; j < PLATFORM_WINDOW_ROWS; ++j) {
+		const struct Platform* platform = GetPlatformRow(world, j);
+		for (int k = 0; k < platform->segmentCount; ++k) {
+			segmentRows[segmentCount] = platform;
+			segments[segmentCount++] = k;
+		}
+	}
+	if (segmentCount == 0) {
+		return;
+	}
+
+	// Spread over every segment in turn, the count picks where on it
+	int count = PoolsCount(world->walkingEnemies.pools, world->walkingEnemyCap);
+	for (int i = PoolsSpawn(world->walkingEnemies.pools, world->walkingEnemyCap); i >= 0; i = PoolsSpawn(world->walkingEnemies.pools, world->walkingEnemyCap)) {
+		SetWalkingEnemy(world, i, segmentRows[count % segmentCount], segments[count % segmentCount], count * 37 % 100, 0, 0);
+		count++;
+	}
+}
+
+void SetWalkingEnemyCap(struct GameWorld* world, int cap) {
+	cap = cap < 1 ? 1 : cap;
+	cap = cap > WALKING_ENEMY_CAPACITY ? WALKING_ENEMY_CAPACITY : cap;
+	InitializeWalkingEnemies(&world->walkingEnemies);
+	world->walkingEnemyCap = cap;
+}
+
+#if defined(__AVX__)
+
+// Moves WALKING_ENEMY_LANES walking enemies, starting at slot first, the way WalkingEnemyLogic moved each one on its own:
+// chasing the player inside the detect range (while inside the bounds), else patrolling and turning around at the bounds.
+// Both are worked out for every lane and the one that applies is blended in.
+// Returns a bit per lane that has no health left
+int WalkingEnemyMoveLanes(struct Walking_Enemies* enem, int first, float playerX, float playerY, float dt) {
+	__m256 zero = _mm256_setzero_ps();
+	__m256 one = _mm256_set1_ps(1.0f);
+	__m256 ten = _mm256_set1_ps(10.0f);
+	__m256 twenty = _mm256_set1_ps(20.0f);
+	__m256 t = _mm256_set1_ps(dt);
+	__m256 rate = _mm256_set1_ps((float)ENEMY_SPEED_FRAME_RATE);
+	__m256 x = _mm256_loadu_ps(&enem->x[first]);
+	__m256 dx = _mm256_sub_ps(_mm256_set1_ps(playerX), x);
+	__m256 dy = _mm256_sub_ps(_mm256_set1_ps(playerY), _mm256_loadu_ps(&enem->y[first]));
+	__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+	__m256 range = _mm256_loadu_ps(&enem->detectRange[first]);
+	__m256 halfWidth = _mm256_mul_ps(_mm256_loadu_ps(&enem->width[first]), _mm256_set1_ps(0.5f)); // Same as width / 2.0f
+	__m256 boundL = _mm256_loadu_ps(&enem->boundL[first]);
+	__m256 boundR = _mm256_loadu_ps(&enem->boundR[first]);
+	__m256 speed = _mm256_loadu_ps(&enem->speed[first]);
+	__m256 dir = _mm256_loadu_ps(&enem->dir[first]);
+
+	// Chasing, only while inside the bounds
+	__m256 isChasing = _mm256_cmp_ps(distanceSquared, _mm256_mul_ps(range, range), _CMP_LT_OQ);
+	__m256 isInside = _mm256_and_ps(_mm256_cmp_ps(_mm256_sub_ps(x, halfWidth), boundL, _CMP_GT_OQ), _mm256_cmp_ps(_mm256_add_ps(x, halfWidth), boundR, _CMP_LT_OQ));
+	__m256 chaseX = _mm256_add_ps(x, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_div_ps(dx, _mm256_sqrt_ps(distanceSquared)), speed), rate), t));
+	__m256 chaseDir = _mm256_and_ps(_mm256_cmp_ps(dx, zero, _CMP_GT_OQ), one);
+
+	// Patrolling, turning around at the bounds
+	__m256 patrolStep = _mm256_mul_ps(_mm256_mul_ps(speed, t), twenty);
+	__m256 patrolX = _mm256_blendv_ps(_mm256_sub_ps(x, patrolStep), _mm256_add_ps(x, patrolStep), _mm256_cmp_ps(dir, zero, _CMP_NEQ_OQ));
+	__m256 isAtLeft = _mm256_cmp_ps(_mm256_sub_ps(_mm256_sub_ps(patrolX, halfWidth), ten), boundL, _CMP_LT_OQ);
+	__m256 isAtRight = _mm256_cmp_ps(_mm256_add_ps(_mm256_add_ps(patrolX, halfWidth), ten), boundR, _CMP_GT_OQ);
+	__m256 patrolDir = _mm256_blendv_ps(_mm256_blendv_ps(dir, zero, isAtRight), one, isAtLeft);
+
+	_mm256_storeu_ps(&enem->x[first], _mm256_blendv_ps(patrolX, _mm256_blendv_ps(x, chaseX, isInside), isChasing));
+	_mm256_storeu_ps(&enem->dir[first], _mm256_blendv_ps(patrolDir, _mm256_blendv_ps(dir, chaseDir, isInside), isChasing));
+
+	__m256 health = _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*)&enem->health[first]));
+	return _mm256_movemask_ps(_mm256_cmp_ps(health, zero, _CMP_LE_OQ));
+}
+
+#elif defined(WALKING_ENEMY_SSE)
+
+// Picks a where the mask is set, else b
+static __m128 WalkingEnemySelect(__m128 mask, __m128 a, __m128 b) {
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Same as the AVX version, 4 lanes at a time
+int WalkingEnemyMoveLanes(struct Walking_Enemies* enem, int first, float playerX, float playerY, float dt) {
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 ten = _mm_set1_ps(10.0f);
+	__m128 twenty = _mm_set1_ps(20.0f);
+	__m128 t = _mm_set1_ps(dt);
+	__m128 rate = _mm_set1_ps((float)ENEMY_SPEED_FRAME_RATE);
+	__m128 x = _mm_loadu_ps(&enem->x[first]);
+	__m128 dx = _mm_sub_ps(_mm_set1_ps(playerX), x);
+	__m128 dy = _mm_sub_ps(_mm_set1_ps(playerY), _mm_loadu_ps(&enem->y[first]));
+	__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+	__m128 range = _mm_loadu_ps(&enem->detectRange[first]);
+	__m128 halfWidth = _mm_mul_ps(_mm_loadu_ps(&enem->width[first]), _mm_set1_ps(0.5f)); // Same as width / 2.0f
+	__m128 boundL = _mm_loadu_ps(&enem->boundL[first]);
+	__m128 boundR = _mm_loadu_ps(&enem->boundR[first]);
+	__m128 speed = _mm_loadu_ps(&enem->speed[first]);
+	__m128 dir = _mm_loadu_ps(&enem->dir[first]);
+
+	// Chasing, only while inside the bounds
+	__m128 isChasing = _mm_cmplt_ps(distanceSquared, _mm_mul_ps(range, range));
+	__m128 isInside = _mm_and_ps(_mm_cmpgt_ps(_mm_sub_ps(x, halfWidth), boundL), _mm_cmplt_ps(_mm_add_ps(x, halfWidth), boundR));
+	__m128 chaseX = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_div_ps(dx, _mm_sqrt_ps(distanceSquared)), speed), rate), t));
+	__m128 chaseDir = _mm_and_ps(_mm_cmpgt_ps(dx, zero), one);
+
+	// Patrolling, turning around at the bounds
+	__m128 patrolStep = _mm_mul_ps(_mm_mul_ps(speed, t), twenty);
+	__m128 patrolX = WalkingEnemySelect(_mm_cmpneq_ps(dir, zero), _mm_add_ps(x, patrolStep), _mm_sub_ps(x, patrolStep));
+	__m128 isAtLeft = _mm_cmplt_ps(_mm_sub_ps(_mm_sub_ps(patrolX, halfWidth), ten), boundL);
+	__m128 isAtRight = _mm_cmpgt_ps(_mm_add_ps(_mm_add_ps(patrolX, halfWidth), ten), boundR);
+	__m128 patrolDir = WalkingEnemySelect(isAtLeft, one, WalkingEnemySelect(isAtRight, zero, dir));
+
+	_mm_storeu_ps(&enem->x[first], WalkingEnemySelect(isChasing, WalkingEnemySelect(isInside, chaseX, x), patrolX));
+	_mm_storeu_ps(&enem->dir[first], WalkingEnemySelect(isChasing, WalkingEnemySelect(isInside, chaseDir, dir), patrolDir));
+
+	__m128i health = _mm_loadu_si128((const __m128i*)&enem->health[first]);
+	return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(health, _mm_set1_epi32(1))));
+}
+
+#else
+
+// Without SIMD the lanes are moved one at a time, same operations as above
+int WalkingEnemyMoveLanes(struct Walking_Enemies* enem, int first, float playerX, float playerY, float dt) {
+	int dead = 0;
+	for (int i = first; i < first + WALKING_ENEMY_LANES; ++i) {
+		float halfWidth = enem->width[i] / 2.0f;
+		float dx = playerX - enem->x[i]; // Calculate the X distance to the player
+		float dy = playerY - enem->y[i]; // Calculate the Y distance to the player
+		float distanceSquared = dx * dx + dy * dy; // Square of the distance, only chasing needs the distance itself
+		if (distanceSquared < enem->detectRange[i] * enem->detectRange[i]) {
+			if (enem->x[i] - halfWidth > enem->boundL[i] && enem->x[i] + halfWidth < enem->boundR[i]) {
+				float dir_x = dx / sqrtf(distanceSquared);
+				enem->x[i] += dir_x * enem->speed[i] * ENEMY_SPEED_FRAME_RATE * dt;
+				enem->dir[i] = dx > 0 ? 1.0f : 0.0f;
 			}
-			if (enem[i].x != 0 && enem[i].x != 1600) { // if there was no error with the position set
-				enem[i].isActive = 1;
+		} else {
+			if (enem->dir[i] == 0) { // 0 is left
+				enem->x[i] -= enem->speed[i] * dt * 20;
+			} else { // 1 is right
+				enem->x[i] += enem->speed[i] * dt * 20;
 			}
-			count++;
-			if (count >= enemyCount) { // if spawn count reaches set count
-				break;
+			if (enem->x[i] - halfWidth - 10 < enem->boundL[i]) {
+				enem->dir[i] = 1;
+			} else if (enem->x[i] + halfWidth + 10 > enem->boundR[i]) {
+				enem->dir[i] = 0;
 			}
 		}
+		dead |= (enem->health[i] <= 0) << (i - first);
 	}
+	return dead;
 }
 
-void WalkingEnemyLogic(struct Player player, struct Walking_Enemy enem[]) {
-	for (int i = 0; i < MAX_WALKING_ENEMIES; ++i) {
-		if (enem[i].isActive) {
-			float dx = player.x - enem[i].x; // Calculate the X distance to the player
-			float dy = player.y - enem[i].y; // Calculate the Y distance to the player
-			float distance_to_player = sqrtf(dx * dx + dy * dy); // Calculate the distance
-			if (distance_to_player < enem[i].detectRange) {
-				if (enem[i].x - enem[i].width / 2.0f > enem[i].boundL && enem[i].x + enem[i].width / 2.0f < enem[i].boundR) {
-					float dir_x = dx / distance_to_player;
-					enem[i].x += dir_x * enem[i].speed;
-					if (dx > 0) {
-						enem[i].dir = 1;
-					} else {
-						enem[i].dir = 0;
+#endif
+
+void WalkingEnemyLogic(struct GameWorld* world, float dt) {
+	struct Walking_Enemies* enem = &world->walkingEnemies;
+	float playerX = world->player.x, playerY = world->player.y;
+	for (int p = 0; p * POOL_CAPACITY < world->walkingEnemyCap; ++p) {
+		// Groups of lanes with an enemy in them are moved as a whole, the free slots in them are moved too,
+		// nothing reads them until they are spawned again
+		unsigned long long live = enem->pools[p].live;
+		for (int lane = 0; live; lane += WALKING_ENEMY_LANES, live >>= WALKING_ENEMY_LANES) {
+			int group = (int)(live & ((1 << WALKING_ENEMY_LANES) - 1));
+			if (group) {
+				int first = p * POOL_CAPACITY + lane;
+				int dead = WalkingEnemyMoveLanes(enem, first, playerX, playerY, dt) & group;
+				for (int i = 0; dead; ++i, dead >>= 1) {
+					if (dead & 1) {
+						PoolsDespawn(enem->pools, first + i);
 					}
 				}
-			} else {
-				if (!enem[i].dir) { // 0 is left
-					enem[i].x -= enem[i].speed * CP_System_GetDt() * 20;
-				} else if (enem[i].dir) { // 1 is right
-					enem[i].x += enem[i].speed * CP_System_GetDt() * 20;
-				}
-				if (enem[i].x - enem[i].width / 2.0f - 10 < enem[i].boundL) {
-					enem[i].dir = 1;
-				} else if (enem[i].x + enem[i].width / 2.0f + 10 > enem[i].boundR) {
-					enem[i].dir = 0;
-				}
 			}
 		}
-		if (enem[i].health <= 0) {
-			enem[i].isActive = 0;
+	}
+}
+
+// Lowest walking enemy slot in use the bullet hits, out of the slots in nearby (all of them up to cap if nearby is NULL).
+// The same enemy as going through every slot in order would hit first. -1 if none
+int FirstWalkingEnemyHit(const struct Bullet* bullet, const struct Walking_Enemies* enemies, int cap, const int nearby[], int nearbyCount) {
+	if (nearby == NULL) { // Every slot, in order
+		for (int first = 0; first < cap; first += COLLIDE_BATCH) {
+			unsigned int live = PoolsBits(enemies->pools, first, cap - first < COLLIDE_BATCH ? cap - first : COLLIDE_BATCH);
+			unsigned int hits = live ? CircleHitsRects(bullet->x, bullet->y, bullet->diameterSize, &enemies->x[first], &enemies->y[first], &enemies->width[first], &enemies->height[first], CollideCount(live)) & live : 0;
+			if (hits) {
+				return first + CollideFirst(hits);
+			}
+		}
+		return -1;
+	}
+
+	int hit = -1;
+	for (int first = 0; first < nearbyCount; first += COLLIDE_BATCH) {
+		int count = nearbyCount - first < COLLIDE_BATCH ? nearbyCount - first : COLLIDE_BATCH;
+		float xs[COLLIDE_BATCH], ys[COLLIDE_BATCH], widths[COLLIDE_BATCH], heights[COLLIDE_BATCH];
+		for (int k = 0; k < count; ++k) {
+			int j = nearby[first + k];
+			xs[k] = enemies->x[j];
+			ys[k] = enemies->y[j];
+			widths[k] = enemies->width[j];
+			heights[k] = enemies->height[j];
+		}
+		unsigned int hits = CircleHitsRects(bullet->x, bullet->y, bullet->diameterSize, xs, ys, widths, heights, count);
+		for (int k = 0; hits; ++k, hits >>= 1) {
+			int j = nearby[first + k];
+			if ((hits & 1) && (hit < 0 || j < hit) && PoolsIsLive(enemies->pools, j)) {
+				hit = j;
+			}
 		}
 	}
+	return hit;
 }
 
-void BulletHitWalkingEnemy(struct Bullet bullets[], struct Walking_Enemy enemies[], struct Player* player, struct Pickups pickup[]) {
-	for (int i = 0; i < MAX_BULLETS; ++i) {
-		if (bullets[i].isActive) {
-			for (int j = 0; j < MAX_WALKING_ENEMIES; ++j) {
-				if (enemies[j].isActive) {
-					// Check for collision between the bullet and the enemy.
-					if (IsCircleAndRectIntersecting(bullets[i].x, bullets[i].y, bullets[i].diameterSize, enemies[j].x, enemies[j].y, (float)enemies[j].width, (float)enemies[j].height)) {
-						bullets[i].isActive = 0; // Deactivate the bullet.
-						enemies[j].health -= player->damage;
-						if (enemies[j].health <= 0) {
-							enemies[j].isActive = 0;
-							player->killCount += 1;
-							SpawnHealthPickup(pickup, enemies[j].x, enemies[j].y, PICKUP_DROP_CHANCE);
-						}
-						break;
-					}
-				}
+void BulletHitWalkingEnemy(struct GameWorld* world) {
+	struct Entity_Pool* bulletPool = &world->bulletPool;
+	struct Bullet* bullets = world->bullets;
+	struct Walking_Enemies* enemies = &world->walkingEnemies;
+	struct Player* player = &world->player;
+	int cap = world->walkingEnemyCap;
+	if (PoolNext(bulletPool, -1) < 0) {
+		return;
+	}
+	// With few bullets or enemies, testing every pair is cheaper than building the grid
+	struct Entity_Grid grid;
+	int isGridded = PoolCount(bulletPool) >= GRID_MIN_QUERIES && PoolsCount(enemies->pools, cap) >= GRID_MIN_ENTITIES;
+	if (isGridded) {
+		GridStart(&grid, 0, world->maxY - WINDOW_HEIGHT / 2.0f);
+		for (int j = PoolsNext(enemies->pools, cap, -1); j >= 0; j = PoolsNext(enemies->pools, cap, j)) {
+			GridAdd(&grid, j, enemies->x[j], enemies->y[j], enemies->width[j] / 2.0f, enemies->height[j] / 2.0f);
+		}
+		GridSort(&grid);
+	}
+
+	int nearby[WALKING_ENEMY_CAPACITY];
+	for (int i = PoolNext(bulletPool, -1); i >= 0; i = PoolNext(bulletPool, i)) {
+		// Check for collision between the bullet and the enemies.
+		int hit;
+		if (isGridded) {
+			hit = FirstWalkingEnemyHit(&bullets[i], enemies, cap, nearby, GridQuery(&grid, bullets[i].x, bullets[i].y, bullets[i].diameterSize / 2.0f, nearby));
+		} else {
+			hit = FirstWalkingEnemyHit(&bullets[i], enemies, cap, NULL, 0);
+		}
+		if (hit >= 0) {
+			PoolDespawn(bulletPool, i); // Deactivate the bullet.
+			enemies->health[hit] -= player->damage;
+			if (enemies->health[hit] <= 0) {
+				PoolsDespawn(enemies->pools, hit);
+				player->killCount += 1;
+				SpawnHealthPickup(world, enemies->x[hit], enemies->y[hit], PICKUP_DROP_CHANCE);
 			}
 		}
 	}
 }
 
-void WalkingEnemyTouchPlayer(struct Walking_Enemy enemies[], struct Player* player) {
-	for (int i = 0; i < MAX_WALKING_ENEMIES; i++) {
-		if (enemies[i].isActive) {
-			// Check for collision between the Player and the enemy.
-			if (AreRectanglesIntersecting(enemies[i].x, enemies[i].y, (float)enemies[i].width, (float)enemies[i].height, player->x, player->y, player->width, player->height)) {
+int WalkingEnemyTouchPlayer(struct GameWorld* world) {
+	struct Walking_Enemies* enemies = &world->walkingEnemies;
+	struct Player* player = &world->player;
+	int cap = world->walkingEnemyCap;
+	int hits = 0;
+	for (int first = 0; first < cap; first += COLLIDE_BATCH) {
+		int count = cap - first < COLLIDE_BATCH ? cap - first : COLLIDE_BATCH;
+		unsigned int live = PoolsBits(enemies->pools, first, count);
+		if (!live) {
+			continue;
+		}
+		// Check for collision between the Player and the enemies. Free slots are tested too, their bits are left out
+		unsigned int touched = RectHitsRects(player->x, player->y, player->width, player->height, &enemies->x[first], &enemies->y[first], &enemies->width[first], &enemies->height[first], CollideCount(live)) & live;
+		for (int k = 0; touched; ++k, touched >>= 1) {
+			if (touched & 1) {
 				player->currentHealth -= 1;
-				CP_Sound_Play(player->damagedSFX);
-				enemies[i].isActive = 0;
+				PoolsDespawn(enemies->pools, first + k);
+				hits++;
 			}
 		}
 	}
+	return hits;
 }
 
-void DespawnWalkingEnemy(struct Walking_Enemy enem[], float maxY) {
-	for (int i = 0; i < MAX_WALKING_ENEMIES; ++i) {
-		if (enem[i].isActive && enem[i].y < maxY - CP_System_GetWindowHeight() / 2.0f) {
-			enem[i].isActive = 0;
+void DespawnWalkingEnemy(struct GameWorld* world) {
+	struct Walking_Enemies* enem = &world->walkingEnemies;
+	int cap = world->walkingEnemyCap;
+	for (int i = PoolsNext(enem->pools, cap, -1); i >= 0; i = PoolsNext(enem->pools, cap, i)) {
+		if (enem->y[i] < world->maxY - WINDOW_HEIGHT / 2.0f) {
+			PoolsDespawn(enem->pools, i);
 		}
 	}
 }
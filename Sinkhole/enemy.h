@@ -15,6 +15,9 @@
 //		Added BulletHitWalkingEnemy()
 //		Added WalkingEnemyTouchPlayer()
 //		DespawnWalkingEnemy()
+// l.zheneudamon
+//		Added StressSpawningWalking()
+//		Added SetWalkingEnemyCap()
 //
 // brief:
 // Contains the function definitions for spawning flying and walking enemies and their respective behaviour logic 
@@ -28,78 +31,84 @@
 /// <summary>
 /// Spawn Flying Enemies outside of Screen, below Player.
 /// </summary>
-/// <param name="enemies">Array of Flying Enemies</param>
+/// <param name="world">Address of Game World</param>
 /// <param name="enemyCount">Number of Flying Enemies to Spawn</param>
-/// <param name="maxY">Midpoint of Screen Y Value</param>
 /// <param name="healthModifier">Increment Health Modifier for Spawned Enemy. Leave as 0 to spawn base health</param>
 /// <param name="speedModifier">Increment Speed Modifier for Spawned Enemy. Leave as 0 to spawn base speed</param>
-void ContinuousSpawningFlying(struct Flying_Enemy enemies[], int enemyCount, float maxY, int healthModifier, int speedModifier);
+void ContinuousSpawningFlying(struct GameWorld* world, int enemyCount, int healthModifier, int speedModifier);
 
 /// <summary>
 /// Handles Flying of Active Flying Enemies.
 /// </summary>
-/// <param name="player">Player</param>
-/// <param name="enemies">Array of Flying Enemies</param>
-void UpdateFlyingEnemies(struct Player player, struct Flying_Enemy enemies[]);
+/// <param name="world">Address of Game World</param>
+/// <param name="dt">Time Step in Seconds</param>
+void UpdateFlyingEnemies(struct GameWorld* world, float dt);
 
 /// <summary>
 /// Handles Bullet Enemy Interaction.
 /// </summary>
-/// <param name="bullets">Array of Bullet</param>
-/// <param name="enemies">Array of Flying Enemies</param>
-/// <param name="player">Player</param>
-void BulletHitFlyingEnemy(struct Bullet bullets[], struct Flying_Enemy enemies[], struct Player* player);
+/// <param name="world">Address of Game World</param>
+void BulletHitFlyingEnemy(struct GameWorld* world);
 
 /// <summary>
 /// Handles Enemy Player Interaction.
 /// </summary>
-/// <param name="enemies">Array of Flying Enemies</param>
-/// <param name="player">Address of Player</param>
-void FlyingEnemyTouchPlayer(struct Flying_Enemy enemies[], struct Player* player);
+/// <param name="world">Address of Game World</param>
+/// <returns>Number of Flying Enemies that hit the Player</returns>
+int FlyingEnemyTouchPlayer(struct GameWorld* world);
 
 /// <summary>
 /// Deletes Flying Enemies that can't catch up to Player.
 /// </summary>
-/// <param name="enem">Array of Flying Enemies</param>
-/// <param name="maxY">Midpoint of Screen Y</param>
-void DespawnFlyingEnemy(struct Flying_Enemy enem[], float maxY);
+/// <param name="world">Address of Game World</param>
+void DespawnFlyingEnemy(struct GameWorld* world);
 
 /// <summary>
-/// Spawns Walking Enemies on Platforms.
+/// Spawns Walking Enemies on the newest (lowest) Platform.
 /// </summary>
-/// <param name="enem">Array of Walking Enemies</param>
-/// <param name="enemyCount">Number of Enemies to Spawn</param>
-/// <param name="platforms">Array of Platforms</param>
+/// <param name="world">Address of Game World</param>
+/// <param name="enemyCount">Number of Enemies to Spawn, up to PLATFORM_SPAWN_SLOTS (the spawn rolls of the Platform)</param>
 /// <param name="healthModifier">Increment Health Modifier for Spawned Enemy. Leave as 0 to spawn base health</param>
 /// <param name="speedModifier">Increment Speed Modifier for Spawned Enemy. Leave as 0 to spawn base speed</param>
-void ContinuousSpawningWalking(struct Walking_Enemy enem[], int enemyCount, struct Platform platforms[], int healthModifier, int speedModifier);
+void ContinuousSpawningWalking(struct GameWorld* world, int enemyCount, int healthModifier, int speedModifier);
 
 /// <summary>
-/// Handles the walking of Active walking Enemies.
+/// Fills every free Walking Enemy slot up to the cap, spread over the Platforms around the Player.
+/// For stress testing, see SetWalkingEnemyCap.
 /// </summary>
-/// <param name="player">Player</param>
-/// <param name="enem">Array of Walking Enemies</param>
-void WalkingEnemyLogic(struct Player player, struct Walking_Enemy enem[]);
+/// <param name="world">Address of Game World</param>
+void StressSpawningWalking(struct GameWorld* world);
 
 /// <summary>
-/// Handles Bullet Enemy Interaction.
+/// Sets how many Walking Enemies can be alive at once, MAX_WALKING_ENEMIES unless stress testing.
+/// Walking Enemies alive are removed.
+/// </summary>
+/// <param name="world">Address of Game World</param>
+/// <param name="cap">Walking Enemies, 1 to WALKING_ENEMY_CAPACITY</param>
+void SetWalkingEnemyCap(struct GameWorld* world, int cap);
+
+/// <summary>
+/// Handles the walking of Active walking Enemies, several at a time with SIMD.
+/// </summary>
+/// <param name="world">Address of Game World</param>
+/// <param name="dt">Time Step in Seconds</param>
+void WalkingEnemyLogic(struct GameWorld* world, float dt);
+
+/// <summary>
+/// Handles Bullet Enemy Interaction. May drop Health Pickups.
 /// </summary>
-/// <param name="bullets">Array of Bullet</param>
-/// <param name="enemies">Array of Walking Enemies</param>
-/// <param name="player">Player</param>
-/// <param name="pickup">Array of Health Pickups</param>
-void BulletHitWalkingEnemy(struct Bullet bullets[], struct Walking_Enemy enemies[], struct Player* player, struct Pickups pickup[]);
+/// <param name="world">Address of Game World</param>
+void BulletHitWalkingEnemy(struct GameWorld* world);
 
 /// <summary>
 /// Handles Enemy Player Interaction.
 /// </summary>
-/// <param name="enemies">Array of Walking Enemies</param>
-/// <param name="player">Address of Player</param>
-void WalkingEnemyTouchPlayer(struct Walking_Enemy enemies[], struct Player* player);
+/// <param name="world">Address of Game World</param>
+/// <returns>Number of Walking Enemies that hit the Player</returns>
+int WalkingEnemyTouchPlayer(struct GameWorld* world);
 
 /// <summary>
 /// Deletes Walking Enemies that leave the Screen.
 /// </summary>
-/// <param name="enem">Array of Walking Enemies</param>
-/// <param name="maxY">Midpoint of Screen Y</param>
-void DespawnWalkingEnemy(struct Walking_Enemy enem[], float maxY);
+/// <param name="world">Address of Game World</param>
+void DespawnWalkingEnemy(struct GameWorld* world);
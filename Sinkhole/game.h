@@ -5,6 +5,7 @@
 // authors:
 // l.zheneudamon (primary author)
 //		Added declarations
+//		Added Game_SetReplayFile
 //
 // brief:
 // Contains the declaration of functions in game.c.
@@ -18,3 +19,6 @@
 void Game_Init(void);
 void Game_Update(void);
 void Game_Exit(void);
+
+// The next Game_Init plays back this replay instead of starting a new run
+void Game_SetReplayFile(const char* path);
@@ -8,6 +8,12 @@
 //		Added Health Pickups
 //		Added Lazer Hazards
 //		Added Damaged View
+//		Added Text Wrap function
+//		Added Animation Loader and unloader
+//		Added Animator (Get animation image address)
+//		Changed entity drawing to go through the slots in use of their Pool
+//		Changed fonts to come from the Asset Registry, instead of being loaded every frame
+//		Changed Animation Loader and unloader to go through the Asset Registry
 // timo.duethorn
 //		Added drawing of Platforms
 //		Added drawing of Pause Menu
@@ -34,6 +40,9 @@
 #include "cprocessing.h"
 #include "initialize.h"
 #include "utils.h"
+#include "pool.h"
+#include "assets.h"
+#include "graphics.h"
 
 void DrawHeatlhUI(CP_Image healthEmptyUI, CP_Image healthFullUI, int playerCurrentHealth, int playerMaxHealth, float imageSize, float startingYHeight, float wallWidth) {
 	// 0. Adjust height to size
@@ -128,7 +137,7 @@ void DrawUpgradeSelection(
 	}
 }
 
-void DrawPlatforms(struct Platform platforms[],int drawnPlatforms, float platformHeight) {
+void DrawPlatforms(struct Platform platforms[], int firstPlatform, int drawnPlatforms, float platformHeight) {
 	CP_Color black = CP_Color_Create(0, 0, 0, 255);
 	CP_Color grey = CP_Color_Create(99, 99, 99, 255);
 	CP_Settings_Stroke(black);
@@ -136,16 +145,9 @@ void DrawPlatforms(struct Platform platforms[],int drawnPlatforms, float platfor
 
 	// Cycle through platforms array to draw all platforms
 	for (int i = 0; i < drawnPlatforms; ++i) {
-		if (platforms[i].start == 0) { // Start with Platform
-			CP_Graphics_DrawRect(platforms[i].p1Coord, platforms[i].y * 100.0f, (float)platforms[i].p1Length, platformHeight);
-			if (platforms[i].p2Length) {
-				CP_Graphics_DrawRect(platforms[i].p2Coord, platforms[i].y * 100.0f, (float)platforms[i].p2Length, platformHeight);
-			}
-		} else if (platforms[i].start == 1) { // Start with Gap
-			CP_Graphics_DrawRect(platforms[i].p1Coord, platforms[i].y * 100.0f, (float)platforms[i].p1Length, platformHeight);
-			if (platforms[i].p2Length) {
-				CP_Graphics_DrawRect(platforms[i].p2Coord, platforms[i].y * 100.0f, (float)platforms[i].p2Length, platformHeight);
-			}
+		struct Platform* platform = &platforms[(firstPlatform + i) & (MAX_PLATFORMS - 1)]; // The array is a ring buffer
+		for (int j = 0; j < platform->segmentCount; ++j) {
+			CP_Graphics_DrawRect((platform->left[j] + platform->right[j]) / 2.0f, platform->y * 100.0f, platform->right[j] - platform->left[j], platformHeight);
 		}
 	}
 }
@@ -211,6 +213,7 @@ void DrawAfterUpgradeSelection(CP_Image upgradeIcon, char upgradeName[], char up
 void DrawUpgradeUI(CP_Image upgradeIcon[], int playerUpgrades[], float imageSize, float startingYHeight, float wallWidth) {
 	// 0. Adjust height to size
 	startingYHeight -= imageSize / 2.0f;
+	CP_Font exclaimFont = Assets_GetFont(Assets_LoadFont("Assets/Fonts/Exo2-Regular.ttf"));
 
 	// 0. Create Array to draw only Upgrades Gotten
 	int upgradesAvailable[MAX_UPGRADES] = { 0 }; // "0"s in upgradesAvailable will be ignored.
@@ -241,7 +244,6 @@ void DrawUpgradeUI(CP_Image upgradeIcon[], int playerUpgrades[], float imageSize
 			// Counter for repeatable upgrades
 			if (elementOfImage < 3) {
 				float offset = imageSize * 3.0f / 8.0f;
-				CP_Font exclaimFont = CP_Font_Load("Assets/Fonts/Exo2-Regular.ttf");
 				CP_Settings_TextSize(20.0f);
 				CP_Font_Set(exclaimFont);
 				CP_Settings_Fill(CP_Color_Create(0, 0, 0, 255));
@@ -272,7 +274,7 @@ void DrawPauseMenu(float maxY, int selectedButton) {
 	CP_Color black = CP_Color_Create(0, 0, 0, 255);
 	CP_Color lightBrown = CP_Color_Create(245, 222, 179, 255);
 
-	CP_Font buttonsFont = CP_Font_Load("Assets/Fonts/Margarine-Regular.ttf");
+	CP_Font buttonsFont = Assets_GetFont(Assets_LoadFont("Assets/Fonts/Margarine-Regular.ttf"));
 
 	CP_Settings_TextAlignment(CP_TEXT_ALIGN_H_CENTER, CP_TEXT_ALIGN_V_MIDDLE);
 
@@ -328,9 +330,9 @@ void DrawDefeatText(float maxY, float scoreMultiplier, int selectedButton) {
 	CP_Color darkRed = CP_Color_Create(130, 16, 29, 255);
 	CP_Color lightBrown = CP_Color_Create(245, 222, 179, 255);
 
-	CP_Font buttonFont = CP_Font_Load("Assets/Fonts/Margarine-Regular.ttf");
-	CP_Font defeatFont = CP_Font_Load("Assets/Fonts/IMFeENsc28P.ttf");
-	CP_Font scoreFont = CP_Font_Load("Assets/Fonts/PressStart2P-Regular.ttf");
+	CP_Font buttonFont = Assets_GetFont(Assets_LoadFont("Assets/Fonts/Margarine-Regular.ttf"));
+	CP_Font defeatFont = Assets_GetFont(Assets_LoadFont("Assets/Fonts/IMFeENsc28P.ttf"));
+	CP_Font scoreFont = Assets_GetFont(Assets_LoadFont("Assets/Fonts/PressStart2P-Regular.ttf"));
 
 	CP_Graphics_ClearBackground(white);
 	CP_Settings_TextAlignment(CP_TEXT_ALIGN_H_CENTER, CP_TEXT_ALIGN_V_MIDDLE);
@@ -367,89 +369,82 @@ void DrawDefeatText(float maxY, float scoreMultiplier, int selectedButton) {
 	}
 }
 
-void DrawPickupHealth(struct Pickups pickups[]) {
-	for (int i = 0; i < MAX_HEALTH_PICKUPS; ++i) {
-		if (pickups[i].isActive) { // &pickup[i].imageAddress
-			CP_Image_Draw(*pickups[i].imageAddress, pickups[i].x, pickups[i].y, pickups[i].imageSize, pickups[i].imageSize, 255);
-		}
+void DrawPickupHealth(struct Pickups pickups[], const struct Entity_Pool* pool, CP_Image pickupsHealth[], float gameTimer) {
+	CP_Image *imageAddress = GetAnimationImageAddress(pickupsHealth, MAX_FRAME_PICKUP_HEALTH, gameTimer);
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		CP_Image_Draw(*imageAddress, pickups[i].x, pickups[i].y, pickups[i].imageSize, pickups[i].imageSize, 255);
 	}
 }
 
-void DrawBullets(struct Bullet bullets[], CP_Image bulletImage) {
-	for (int i = 0; i < MAX_BULLETS; i++) {
-		if (bullets[i].isActive) {
-			CP_Image_Draw(bulletImage, bullets[i].x, bullets[i].y, bullets[i].diameterSize, bullets[i].diameterSize, 255);
-		}
+void DrawBullets(struct Bullet bullets[], const struct Entity_Pool* pool, CP_Image bulletImage) {
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		CP_Image_Draw(bulletImage, bullets[i].x, bullets[i].y, bullets[i].diameterSize, bullets[i].diameterSize, 255);
 	}
 }
 
-void DrawFlyingEnemies(struct Flying_Enemy enemies[], struct Player player, CP_Image enemyLeft[], CP_Image enemyRight[], float gameTimer) {
-	for (int i = 0; i < MAX_FLYING_ENEMIES; i++) {
-		if (enemies[i].isActive) {
-			if (enemies[i].x < player.x) { // Right
-				enemies[i].imageAddress = GetAnimationImageAddress(enemyRight, MAX_FRAME_ENEMY_FLYING_RIGHT, gameTimer);
-			} else { // Left
-				enemies[i].imageAddress = GetAnimationImageAddress(enemyLeft, MAX_FRAME_ENEMY_FLYING_LEFT, gameTimer);
-			}
-			CP_Image_Draw(*enemies[i].imageAddress, enemies[i].x, enemies[i].y, enemies[i].diameter, enemies[i].diameter, 255);
+void DrawFlyingEnemies(struct Flying_Enemy enemies[], const struct Entity_Pool* pool, struct Player player, CP_Image enemyLeft[], CP_Image enemyRight[], float gameTimer) {
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		CP_Image *imageAddress;
+		if (enemies[i].x < player.x) { // Right
+			imageAddress = GetAnimationImageAddress(enemyRight, MAX_FRAME_ENEMY_FLYING_RIGHT, gameTimer);
+		} else { // Left
+			imageAddress = GetAnimationImageAddress(enemyLeft, MAX_FRAME_ENEMY_FLYING_LEFT, gameTimer);
 		}
+		CP_Image_Draw(*imageAddress, enemies[i].x, enemies[i].y, enemies[i].diameter, enemies[i].diameter, 255);
 	}
 }
 
-void DrawLazerHazard(struct Lazer_Hazard lazerHazard[], float gameTimer, float wallWidth) {
-	for (int i = 0; i < MAX_LAZER_HAZARDS; ++i) {
-		if (lazerHazard[i].isActive) {
-			// Following the sequence of "blink, blink, zap"
-			// Will show yellow twice, before showing orange
-			float animationMultiplier = lazerHazard[i].timeToFire / 3.0f; // Determines how long the lazer blinks for
-			float animationTimer = gameTimer - lazerHazard[i].timeCreated; // Time from 0 up to how long the lazer blinks for
-			for (int j = 0; j < 2; ++j) { // Because of "blink, blink, zap". Only 2 times
-				if (animationTimer > animationMultiplier) {
-					animationTimer -= animationMultiplier;
-				} else {
-					break;
-				}
-			}
-			int yellowAlpha = (int)(50 * animationTimer);
-			int orangeAlpha = (int)(255 * animationTimer);
-			CP_Color yellow = CP_Color_Create(242, 242, 23, yellowAlpha);
-			CP_Color orange = CP_Color_Create(255, 102, 0, orangeAlpha);
-			float growingHeight = lazerHazard[i].height * animationTimer;
-			if (gameTimer > lazerHazard[i].timeCreated + (lazerHazard[i].timeToFire * 2.0f / 3.0f)) { // Shoot Orange Lazer
-				CP_Settings_Fill(orange);
-				CP_Graphics_DrawRect(CP_System_GetWindowWidth() / 2.0f, lazerHazard[i].y, CP_System_GetWindowWidth() - 2 * wallWidth, growingHeight);
+void DrawLazerHazard(struct Lazer_Hazard lazerHazard[], const struct Entity_Pool* pool, float gameTimer, float wallWidth) {
+	CP_Font exclaimFont = Assets_GetFont(Assets_LoadFont("Assets/Fonts/Exo2-Regular.ttf"));
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		// Following the sequence of "blink, blink, zap"
+		// Will show yellow twice, before showing orange
+		float animationMultiplier = lazerHazard[i].timeToFire / 3.0f; // Determines how long the lazer blinks for
+		float animationTimer = gameTimer - lazerHazard[i].timeCreated; // Time from 0 up to how long the lazer blinks for
+		for (int j = 0; j < 2; ++j) { // Because of "blink, blink, zap". Only 2 times
+			if (animationTimer > animationMultiplier) {
+				animationTimer -= animationMultiplier;
 			} else {
-				CP_Settings_Fill(yellow);
-				CP_Graphics_DrawRect(CP_System_GetWindowWidth() / 2.0f, lazerHazard[i].y, CP_System_GetWindowWidth() - 2 * wallWidth, growingHeight);
+				break;
 			}
-			// Let 25 be offset from Left Side of Right Side Wall
-			// Triangle will span 100 x 100. X value of triangle center will be 25 + 50
-			float warningTriangleX = CP_System_GetWindowWidth() - wallWidth + 75;
-			float warningTriangleY = lazerHazard[i].y;
-			float trianglePoint1X = warningTriangleX - 50, trianglePoint1Y = warningTriangleY + 50;
-			float trianglePoint2X = warningTriangleX, trianglePoint2Y = warningTriangleY - 50;
-			float trianglePoint3X = warningTriangleX + 50, trianglePoint3Y = warningTriangleY + 50;
-			CP_Settings_Fill(CP_Color_Create(255, 0, 0, 255));
-			CP_Graphics_DrawTriangle(trianglePoint1X, trianglePoint1Y, trianglePoint2X, trianglePoint2Y, trianglePoint3X, trianglePoint3Y);
-			CP_Font exclaimFont = CP_Font_Load("Assets/Fonts/Exo2-Regular.ttf");
-			CP_Settings_TextSize(120.0f);
-			CP_Font_Set(exclaimFont);
-			CP_Settings_Fill(CP_Color_Create(255, 255, 255, 255));
-			CP_Font_DrawText("!", warningTriangleX + 14, warningTriangleY + 5); // Offset to match center of triangle
 		}
+		int yellowAlpha = (int)(50 * animationTimer);
+		int orangeAlpha = (int)(255 * animationTimer);
+		CP_Color yellow = CP_Color_Create(242, 242, 23, yellowAlpha);
+		CP_Color orange = CP_Color_Create(255, 102, 0, orangeAlpha);
+		float growingHeight = lazerHazard[i].height * animationTimer;
+		if (gameTimer > lazerHazard[i].timeCreated + (lazerHazard[i].timeToFire * 2.0f / 3.0f)) { // Shoot Orange Lazer
+			CP_Settings_Fill(orange);
+			CP_Graphics_DrawRect(CP_System_GetWindowWidth() / 2.0f, lazerHazard[i].y, CP_System_GetWindowWidth() - 2 * wallWidth, growingHeight);
+		} else {
+			CP_Settings_Fill(yellow);
+			CP_Graphics_DrawRect(CP_System_GetWindowWidth() / 2.0f, lazerHazard[i].y, CP_System_GetWindowWidth() - 2 * wallWidth, growingHeight);
+		}
+		// Let 25 be offset from Left Side of Right Side Wall
+		// Triangle will span 100 x 100. X value of triangle center will be 25 + 50
+		float warningTriangleX = CP_System_GetWindowWidth() - wallWidth + 75;
+		float warningTriangleY = lazerHazard[i].y;
+		float trianglePoint1X = warningTriangleX - 50, trianglePoint1Y = warningTriangleY + 50;
+		float trianglePoint2X = warningTriangleX, trianglePoint2Y = warningTriangleY - 50;
+		float trianglePoint3X = warningTriangleX + 50, trianglePoint3Y = warningTriangleY + 50;
+		CP_Settings_Fill(CP_Color_Create(255, 0, 0, 255));
+		CP_Graphics_DrawTriangle(trianglePoint1X, trianglePoint1Y, trianglePoint2X, trianglePoint2Y, trianglePoint3X, trianglePoint3Y);
+		CP_Settings_TextSize(120.0f);
+		CP_Font_Set(exclaimFont);
+		CP_Settings_Fill(CP_Color_Create(255, 255, 255, 255));
+		CP_Font_DrawText("!", warningTriangleX + 14, warningTriangleY + 5); // Offset to match center of triangle
 	}
 }
 
-void DrawWalkingEnemies(struct Walking_Enemy enemies[], CP_Image enemyLeft[], CP_Image enemyRight[], float gameTimer) {
-	for (int i = 0; i < MAX_WALKING_ENEMIES; ++i) {
-		if (enemies[i].isActive) {
-			if (enemies[i].dir) { // Right
-				enemies[i].imageAddress = GetAnimationImageAddress(enemyRight, MAX_FRAME_ENEMY_WALKING_RIGHT, gameTimer);
-			} else { // Left
-				enemies[i].imageAddress = GetAnimationImageAddress(enemyLeft, MAX_FRAME_ENEMY_WALKING_LEFT, gameTimer);
-			}
-			CP_Image_Draw(*enemies[i].imageAddress, enemies[i].x, enemies[i].y, (float)enemies[i].width, (float)enemies[i].height, 255);
+void DrawWalkingEnemies(const struct Walking_Enemies* enemies, int cap, CP_Image enemyLeft[], CP_Image enemyRight[], float gameTimer) {
+	for (int i = PoolsNext(enemies->pools, cap, -1); i >= 0; i = PoolsNext(enemies->pools, cap, i)) {
+		CP_Image *imageAddress;
+		if (enemies->dir[i]) { // Right
+			imageAddress = GetAnimationImageAddress(enemyRight, MAX_FRAME_ENEMY_WALKING_RIGHT, gameTimer);
+		} else { // Left
+			imageAddress = GetAnimationImageAddress(enemyLeft, MAX_FRAME_ENEMY_WALKING_LEFT, gameTimer);
 		}
+		CP_Image_Draw(*imageAddress, enemies->x[i], enemies->y[i], enemies->width[i], enemies->height[i], 255);
 	}
 }
 
@@ -458,3 +453,59 @@ void DrawDamagedView(struct Player player, float maxY, CP_Image damagedScreen) {
 	int opacityAlpha = (int)(50 * opacityScale);
 	CP_Image_Draw(damagedScreen, CP_System_GetWindowWidth() / 2.0f, maxY, CP_System_GetWindowWidth() + 50.0f, CP_System_GetWindowHeight() + 50.0f, opacityAlpha);
 }
+
+void DrawTextWithWrap(char text[], float x, float y, int charactersPerLine, float gapBetweenEachLine) {
+	char textString[MAX_UPGRADE_TEXT] = { 0 };
+	sprintf_s(textString, MAX_UPGRADE_TEXT, "%s", text);
+	int lastWordPosition = 0, currentLine = 0;
+	for (int i = 0; i < MAX_UPGRADE_TEXT; i++) {
+		if (textString[i] == ' ') {
+			lastWordPosition = i;
+		}
+
+		if (i && i % charactersPerLine == 0) {
+			textString[lastWordPosition] = '\0';
+			CP_Font_DrawText(textString, x, y + currentLine * gapBetweenEachLine);
+			CutString(textString, MAX_UPGRADE_TEXT, lastWordPosition + 1);
+			i = -1, currentLine++;
+			continue;
+		}
+
+		if (textString[i] == '\0') {
+			break;
+		}
+	}
+	CP_Font_DrawText(textString, x, y + currentLine * gapBetweenEachLine);
+}
+
+void AnimationImageLoader(CP_Image imageArray[], char fileName[], int numberOfFrames) {
+	for (int i = 0; i < numberOfFrames; ++i) {
+		char filePath[MAX_ASSET_FILEPATH] = "Assets/Images/";
+		strcat_s(filePath, MAX_ASSET_FILEPATH, fileName);
+		char frameNumber[MAX_FRAME_DIGITS] = {0};
+		snprintf(frameNumber, MAX_FRAME_DIGITS, "%d", i);
+		strcat_s(filePath, MAX_ASSET_FILEPATH, frameNumber);
+		strcat_s(filePath, MAX_ASSET_FILEPATH, ".png");
+		imageArray[i] = Assets_LoadImage(filePath);
+	}
+}
+
+void ImageUnloader(CP_Image imageArray[], int numberOfImage) {
+	for (int i = 0; i < numberOfImage; ++i){
+		Assets_ReleaseImage(&imageArray[i]);
+	}
+}
+
+CP_Image* GetAnimationImageAddress(CP_Image arrayImages[], int MAX_FRAME_IN_ANIMATION, float gameTimer) {
+	CP_Image *returningImage = NULL;
+	int animationFrame = (int)(gameTimer * MAX_FRAME_IN_ANIMATION) % MAX_FRAME_IN_ANIMATION;
+	for (int i = MAX_FRAME_IN_ANIMATION - 1; i >= 0; --i) { // Animate through each frame of the player
+		if (animationFrame == i) {
+			returningImage = &arrayImages[i];
+			break;
+		} else {
+			returningImage = &arrayImages[0];
+		}
+	}
+	return returningImage;
+}
@@ -9,6 +9,11 @@
 //		Added Health Pickups
 //		Added Lazer Hazards
 //		Added Damaged View
+//		Added Text Wrap function
+//		Added Animation Loader and unloader
+//		Added Animator (Get animation image address)
+//		Changed entity drawing to go through the slots in use of their Pool
+//		Changed Animation Loader and unloader to go through the Asset Registry
 // timo.duethorn
 //		Added drawing of Platforms
 //		Added drawing of Pause Menu
@@ -43,10 +48,11 @@ void DrawHeatlhUI(CP_Image healthEmptyUI, CP_Image healthFullUI, int playerCurre
 /// <summary>
 /// Draws the Platforms.
 /// </summary>
-/// <param name="platforms"> Array of Platforms </param>
+/// <param name="platforms"> Ring Buffer of Platforms </param>
+/// <param name="firstPlatform"> Index of the first drawn Platform </param>
 /// <param name="drawnPlatforms"> Number of drawn Platforms </param>
 /// <param name="platformHeight"> The actual pixel height of each individual Platform </param>
-void DrawPlatforms(struct Platform platforms[], int drawnPlatforms, float platformHeight);
+void DrawPlatforms(struct Platform platforms[], int firstPlatform, int drawnPlatforms, float platformHeight);
 
 /// <summary>
 /// Draws the upgrade selection with animations.
@@ -108,41 +114,48 @@ void DrawDefeatText(float maxY, float scoreMultiplier, int selectedButton);
 /// Draws the Pickups.
 /// </summary>
 /// <param name="pickup"> Array of Pickups </param>
-void DrawPickupHealth(struct Pickups pickup[]);
+/// <param name="pool"> Pool of the Pickups </param>
+/// <param name="pickupsHealth"> Array of Frames of Health Pickup </param>
+/// <param name="gameTimer"> Time since game started </param>
+void DrawPickupHealth(struct Pickups pickup[], const struct Entity_Pool* pool, CP_Image pickupsHealth[], float gameTimer);
 
 /// <summary>
 /// Draws the Bullets.
 /// </summary>
 /// <param name="bullets"> Array of Bullets </param>
+/// <param name="pool"> Pool of the Bullets </param>
 /// <param name="bulletColor"> Color of Bullet </param>
-void DrawBullets(struct Bullet bullets[], CP_Image bulletImage);
+void DrawBullets(struct Bullet bullets[], const struct Entity_Pool* pool, CP_Image bulletImage);
 
 /// <summary>
 /// Draws flying Enemies.
 /// </summary>
 /// <param name="enemies"> Flying Enemy Struct </param>
+/// <param name="pool"> Pool of the Flying Enemies </param>
 /// <param name="player"> Player </param>
 /// <param name="enemyLeft"> Array of Frames of Enemy Flying Left </param>
 /// <param name="enemyRight"> Array of Frames of Enemy Flying Right </param>
 /// <param name="gameTimer"> Time since game started </param>
-void DrawFlyingEnemies(struct Flying_Enemy enemies[], struct Player player, CP_Image enemyLeft[], CP_Image enemyRight[], float gameTimer);
+void DrawFlyingEnemies(struct Flying_Enemy enemies[], const struct Entity_Pool* pool, struct Player player, CP_Image enemyLeft[], CP_Image enemyRight[], float gameTimer);
 
 /// <summary>
 /// Draws Lazer Hazard.
 /// </summary>
 /// <param name="lazerHazard"> Array of Lazer Hazards </param>
+/// <param name="pool"> Pool of the Lazer Hazards </param>
 /// <param name="gameTimer"> gameTimer </param>
 /// <param name="wallWidth"> Side Wall's Width </param>
-void DrawLazerHazard(struct Lazer_Hazard lazerHazard[], float gameTimer, float wallWidth);
+void DrawLazerHazard(struct Lazer_Hazard lazerHazard[], const struct Entity_Pool* pool, float gameTimer, float wallWidth);
 
 /// <summary>
 /// Draws Walking Enemies.
 /// </summary>
-/// <param name="enemies"> Walking Enemy Struct </param>
+/// <param name="enemies"> Walking Enemies Struct </param>
+/// <param name="cap"> Walking Enemies that can be alive </param>
 /// <param name="enemyLeft"> Array of Frames of Enemy Walking Left </param>
 /// <param name="enemyRight"> Array of Frames of Enemy Walking Right </param>
 /// <param name="gameTimer"> Time since game started </param>
-void DrawWalkingEnemies(struct Walking_Enemy enemies[], CP_Image enemyLeft[], CP_Image enemyRight[], float gameTimer);
+void DrawWalkingEnemies(const struct Walking_Enemies* enemies, int cap, CP_Image enemyLeft[], CP_Image enemyRight[], float gameTimer);
 
 /// <summary>
 /// Draws the Damaged Health View.
@@ -151,3 +164,38 @@ void DrawWalkingEnemies(struct Walking_Enemy enemies[], CP_Image enemyLeft[], CP
 /// <param name="maxY"> Midpoint of Screen Y </param>
 /// <param name="damagedScreen"> Translucent Shades of Red </param>
 void DrawDamagedView(struct Player player, float maxY, CP_Image damagedScreen);
+
+/// <summary>
+/// Draws Text on the screen with wrapping based on max characters.
+/// This function assumes that text is already predefined.
+/// </summary>
+/// <param name="text"> String to print on screen </param>
+/// <param name="x"> X value to draw </param>
+/// <param name="y"> Y value of first line to draw </param>
+/// <param name="charactersPerLine"> Max number of characters in a line </param>
+/// <param name="gapBetweenEachLine"> Space between each line </param>
+void DrawTextWithWrap(char text[], float x, float y, int charactersPerLine, float gapBetweenEachLine);
+
+/// <summary>
+/// Loads Images using Assets_LoadImage.
+/// </summary>
+/// <param name="imageArray"> Array holding the Images </param>
+/// <param name="fileName"> Relative file name of the Images. "Player/player_idle_" </param>
+/// <param name="numberOfFrames"> Number of frames the Image has </param>
+void AnimationImageLoader(CP_Image imageArray[], char fileName[], int numberOfFrames);
+
+/// <summary>
+/// Releases Images using Assets_ReleaseImage. They stay loaded until Assets_Evict.
+/// </summary>
+/// <param name="imageArray"> Array holding the Images </param>
+/// <param name="numberOfImage"> Number of Images </param>
+void ImageUnloader(CP_Image imageArray[], int numberOfImage);
+
+/// <summary>
+/// Selects the correct frame in animation using game Timer.
+/// </summary>
+/// <param name="arrayImages"> Array holding the Images </param>
+/// <param name="MAX_FRAME_IN_ANIMATION"> ENUM of max number of frames/images </param>
+/// <param name="gameTimer"> Timer that increases per frame </param>
+/// <returns> Address of frame Image </returns>
+CP_Image* GetAnimationImageAddress(CP_Image arrayImages[], int MAX_FRAME_IN_ANIMATION, float gameTimer);
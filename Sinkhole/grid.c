@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------------------
+// file: grid.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Uniform Grid for hit detection
+//
+// brief:
+// Builds the grid with a counting sort: GridAdd counts the entities of each
+// cell, GridSort turns the counts into where each cell starts and copies the
+// slots there. Entities keep the order they were added in within a cell.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#include <string.h>
+#include "initialize.h"
+#include "grid.h"
+
+// Column of an x, positions off the grid go in the closest column
+int GridColumn(const struct Entity_Grid* grid, float x) {
+	float column = (x - grid->left) / GRID_CELL_SIZE;
+	if (!(column >= 0)) { // Also catches NaN
+		return 0;
+	}
+	return column < GRID_COLUMNS ? (int)column : GRID_COLUMNS - 1;
+}
+
+int GridRow(const struct Entity_Grid* grid, float y) {
+	float row = (y - grid->top) / GRID_CELL_SIZE;
+	if (!(row >= 0)) {
+		return 0;
+	}
+	return row < GRID_ROWS ? (int)row : GRID_ROWS - 1;
+}
+
+void GridStart(struct Entity_Grid* grid, float left, float top) {
+	grid->left = left;
+	grid->top = top;
+	grid->reachX = 0;
+	grid->reachY = 0;
+	grid->count = 0;
+	memset(grid->cellStart, 0, sizeof(grid->cellStart));
+}
+
+void GridAdd(struct Entity_Grid* grid, int slot, float x, float y, float halfWidth, float halfHeight) {
+	int cell = GridRow(grid, y) * GRID_COLUMNS + GridColumn(grid, x);
+	grid->addedSlot[grid->count] = slot;
+	grid->addedCell[grid->count] = cell;
+	grid->count++;
+	grid->cellStart[cell + 1]++; // Counted one cell along, so the sum up to a cell is where it starts
+	grid->reachX = halfWidth > grid->reachX ? halfWidth : grid->reachX;
+	grid->reachY = halfHeight > grid->reachY ? halfHeight : grid->reachY;
+}
+
+void GridSort(struct Entity_Grid* grid) {
+	int next[GRID_CELLS]; // Where the next entity of each cell goes
+	for (int c = 0; c < GRID_CELLS; ++c) {
+		grid->cellStart[c + 1] += grid->cellStart[c];
+		next[c] = grid->cellStart[c];
+	}
+	for (int i = 0; i < grid->count; ++i) {
+		grid->slots[next[grid->addedCell[i]]++] = grid->addedSlot[i];
+	}
+}
+
+int GridQuery(const struct Entity_Grid* grid, float x, float y, float reach, int slots[]) {
+	// An entity in a cell can stick out of it by up to its half size
+	float reachX = reach + grid->reachX + GRID_MARGIN;
+	float reachY = reach + grid->reachY + GRID_MARGIN;
+	int left = GridColumn(grid, x - reachX);
+	int right = GridColumn(grid, x + reachX);
+	int top = GridRow(grid, y - reachY);
+	int bottom = GridRow(grid, y + reachY);
+	int count = 0;
+	for (int row = top; row <= bottom; ++row) {
+		// The cells of a row are next to each other in slots
+		int first = grid->cellStart[row * GRID_COLUMNS + left];
+		int last = grid->cellStart[row * GRID_COLUMNS + right + 1];
+		for (int i = first; i < last; ++i) {
+			slots[count++] = grid->slots[i];
+		}
+	}
+	return count;
+}
@@ -0,0 +1,84 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: grid.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Uniform Grid for hit detection
+//
+// brief:
+// Contains the declaration of functions in grid.c.
+// A uniform grid over the screen, built each step from the entities that can
+// be hit, so a bullet only tests the entities in the cells around it instead
+// of every entity. Each entity is put in the cell its center is in (entities
+// off the screen go in the closest cell), and a query covers every cell an
+// entity could reach the position from.
+//
+// Building:
+//	GridStart(&grid, left, top);
+//	GridAdd(&grid, slot, x, y, halfWidth, halfHeight); // For each entity
+//	GridSort(&grid);
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+enum {
+	GRID_CELL_SIZE = 100, // Pixels, bigger than any entity so most queries cover few cells
+	GRID_COLUMNS = WINDOW_WIDTH / GRID_CELL_SIZE,
+	GRID_ROWS = WINDOW_HEIGHT / GRID_CELL_SIZE,
+	GRID_CELLS = GRID_COLUMNS * GRID_ROWS,
+	GRID_CAPACITY = WALKING_ENEMY_CAPACITY, // Entities of the largest kind
+	GRID_MARGIN = 1, // Pixels added around a query, for rounding in the hit tests
+	// With fewer entities or queries than these, testing every pair is cheaper than building the grid
+	GRID_MIN_ENTITIES = 16,
+	GRID_MIN_QUERIES = 4,
+};
+
+struct Entity_Grid {
+	float left, top; // Top left corner of the first cell
+	float reachX, reachY; // Largest half size of the entities added
+	int count; // Entities added
+	int cellStart[GRID_CELLS + 1]; // Entities of cell c are slots[cellStart[c]] to slots[cellStart[c + 1] - 1]
+	int slots[GRID_CAPACITY]; // Slots of the entities, by cell
+	int addedSlot[GRID_CAPACITY]; // Entities in the order they were added, until sorted
+	int addedCell[GRID_CAPACITY];
+};
+
+/// <summary>
+/// Empties the grid and places it.
+/// </summary>
+/// <param name="grid">Address of the Grid</param>
+/// <param name="left">X of the left edge of the screen</param>
+/// <param name="top">Y of the top edge of the screen</param>
+void GridStart(struct Entity_Grid* grid, float left, float top);
+
+/// <summary>
+/// Adds an entity. Only found by GridQuery after GridSort.
+/// </summary>
+/// <param name="grid">Address of the Grid</param>
+/// <param name="slot">Slot of the entity in its array</param>
+/// <param name="x">X of the entity's center</param>
+/// <param name="y">Y of the entity's center</param>
+/// <param name="halfWidth">Furthest the entity can be hit from its center on X</param>
+/// <param name="halfHeight">Furthest the entity can be hit from its center on Y</param>
+void GridAdd(struct Entity_Grid* grid, int slot, float x, float y, float halfWidth, float halfHeight);
+
+/// <summary>
+/// Puts the entities added into their cells.
+/// </summary>
+/// <param name="grid">Address of the Grid</param>
+void GridSort(struct Entity_Grid* grid);
+
+/// <summary>
+/// Gets every entity that something at a position could hit.
+/// </summary>
+/// <param name="grid">Address of the Grid</param>
+/// <param name="x">X of the position</param>
+/// <param name="y">Y of the position</param>
+/// <param name="reach">Furthest the thing at the position can hit from it</param>
+/// <param name="slots">Array of size grid->count. This will contain the slots, in no particular order</param>
+/// <returns>Number of slots</returns>
+int GridQuery(const struct Entity_Grid* grid, float x, float y, float reach, int slots[]);
@@ -0,0 +1,263 @@
+//------------------------------------------------------------------------------------
+// file: hash.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added World State Hashing
+//		Changed entities to be hashed from the slots in use of their Pool
+//		Changed the platform hash to leave out lookahead rows
+//
+// brief:
+// Hashes the world after a step. Values are mixed in 32 bits at a time with
+// the xxHash32 round and finished with its avalanche. Floats are hashed by
+// their bits, so any change at all shows. Entities are hashed one by one
+// and added together, which does not depend on which slot they are in.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#include <string.h>
+#include "initialize.h"
+#include "platforms.h"
+#include "pool.h"
+#include "hash.h"
+
+#pragma region hashing
+
+// xxHash32 Primes
+static const unsigned int HASH_PRIME_1 = 0x9E3779B1u;
+static const unsigned int HASH_PRIME_2 = 0x85EBCA77u;
+static const unsigned int HASH_PRIME_3 = 0xC2B2AE3Du;
+static const unsigned int HASH_PRIME_5 = 0x165667B1u;
+
+unsigned int HashRotateLeft(unsigned int x, int k) {
+	return (x << k) | (x >> (32 - k));
+}
+
+unsigned int HashInt(unsigned int hash, int value) {
+	hash += (unsigned int)value * HASH_PRIME_2;
+	return HashRotateLeft(hash, 13) * HASH_PRIME_1;
+}
+
+unsigned int HashFloat(unsigned int hash, float value) {
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return HashInt(hash, (int)bits);
+}
+
+unsigned int HashFinish(unsigned int hash) {
+	hash ^= hash >> 15;
+	hash *= HASH_PRIME_2;
+	hash ^= hash >> 13;
+	hash *= HASH_PRIME_3;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+#pragma endregion
+
+#pragma region parts
+
+unsigned int HashGame(const struct GameWorld* world) {
+	const struct Game_State_Upgrade* upgrade = &world->gameStateUpgrade;
+	unsigned int hash = HASH_PRIME_5;
+	hash = HashInt(hash, world->gameState);
+	hash = HashInt(hash, upgrade->isUpgradeChosen);
+	for (int i = 0; i < 3; ++i) {
+		hash = HashInt(hash, upgrade->upgradeChoice[i]);
+	}
+	hash = HashInt(hash, upgrade->chosenUpgrade);
+	hash = HashFloat(hash, upgrade->distanceToCenter);
+	hash = HashFloat(hash, upgrade->secondsSinceState);
+	hash = HashFloat(hash, upgrade->secondsSinceUpgradeChosen);
+	hash = HashFloat(hash, world->gameStateDefeat.secondsSinceState);
+	hash = HashFloat(hash, world->maxY);
+	hash = HashFloat(hash, world->wallWidth);
+	hash = HashFloat(hash, world->platformHeight);
+	hash = HashFloat(hash, world->scoreMultipler);
+	hash = HashFloat(hash, world->gameTimer);
+	hash = HashFloat(hash, world->lastShotTimer);
+	hash = HashFloat(hash, world->lastSpawnTimer);
+	hash = HashFloat(hash, world->lazerSpawnedTimer);
+	hash = HashInt(hash, world->nextLazerTimer);
+	hash = HashInt(hash, world->isTouching);
+	hash = HashInt(hash, world->doubleJumpUsed);
+	hash = HashInt(hash, world->fallingThroughPlatform);
+	hash = HashInt(hash, world->lastPlayerHeightThreshold);
+	hash = HashInt(hash, world->distanceBetweenPlatform);
+	for (int i = 0; i < MAX_DAMAGE_SOURCES; ++i) {
+		hash = HashInt(hash, world->damageTaken[i]);
+	}
+	return HashFinish(hash);
+}
+
+unsigned int HashPlayer(const struct Player* player) {
+	unsigned int hash = HASH_PRIME_5;
+	hash = HashFloat(hash, player->x);
+	hash = HashFloat(hash, player->y);
+	hash = HashFloat(hash, player->verticalVelocity);
+	hash = HashFloat(hash, player->horizontalVelocity);
+	hash = HashFloat(hash, player->width);
+	hash = HashFloat(hash, player->height);
+	hash = HashInt(hash, player->maxHealth);
+	hash = HashInt(hash, player->currentHealth);
+	hash = HashInt(hash, player->movementSpeed);
+	hash = HashInt(hash, player->jumpSpeed);
+	hash = HashInt(hash, player->animation);
+	hash = HashInt(hash, player->damage);
+	hash = HashInt(hash, player->isShooting);
+	for (int i = 0; i < MAX_UPGRADES; ++i) {
+		hash = HashInt(hash, player->upgrades[i]);
+	}
+	hash = HashInt(hash, player->totalUpgrades);
+	hash = HashInt(hash, player->fireRate);
+	hash = HashInt(hash, player->projectileSize);
+	hash = HashInt(hash, player->projectileSpeed);
+	hash = HashInt(hash, player->killCount);
+	return HashFinish(hash);
+}
+
+// A row is hashed as its height and the edges of its platforms, left to right.
+// Only the rows around the player, lookahead rows are made ahead of time and would be there later without it
+unsigned int HashPlatforms(const struct GameWorld* world) {
+	unsigned int sum = 0;
+	int rows = world->platformCount < PLATFORM_WINDOW_ROWS ? world->platformCount : PLATFORM_WINDOW_ROWS;
+	for (int i = 0; i < rows; ++i) { // Where the ring buffer starts is not part of the state
+		const struct Platform* platform = GetPlatformRow(world, i);
+		unsigned int hash = HASH_PRIME_5;
+		hash = HashInt(hash, platform->y);
+		for (int j = 0; j < platform->segmentCount; ++j) {
+			hash = HashFloat(hash, platform->left[j]);
+			hash = HashFloat(hash, platform->right[j]);
+		}
+		sum += HashFinish(hash);
+	}
+	return sum;
+}
+
+unsigned int HashBullets(const struct Bullet bullets[], const struct Entity_Pool* pool) {
+	unsigned int sum = 0;
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		unsigned int hash = HASH_PRIME_5;
+		hash = HashFloat(hash, bullets[i].x);
+		hash = HashFloat(hash, bullets[i].y);
+		hash = HashFloat(hash, bullets[i].velocity);
+		hash = HashFloat(hash, bullets[i].diameterSize);
+		hash = HashFloat(hash, bullets[i].distanceTraveled);
+		hash = HashFloat(hash, bullets[i].directionX);
+		hash = HashFloat(hash, bullets[i].directionY);
+		sum += HashFinish(hash);
+	}
+	return sum;
+}
+
+unsigned int HashFlyingEnemies(const struct Flying_Enemy enemies[], const struct Entity_Pool* pool) {
+	unsigned int sum = 0;
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		unsigned int hash = HASH_PRIME_5;
+		hash = HashFloat(hash, enemies[i].x);
+		hash = HashFloat(hash, enemies[i].y);
+		hash = HashFloat(hash, enemies[i].diameter);
+		hash = HashInt(hash, enemies[i].enemyHealth);
+		hash = HashInt(hash, enemies[i].enemySpeed);
+		sum += HashFinish(hash);
+	}
+	return sum;
+}
+
+unsigned int HashWalkingEnemies(const struct Walking_Enemies* enemies, int cap) {
+	unsigned int sum = 0;
+	for (int i = PoolsNext(enemies->pools, cap, -1); i >= 0; i = PoolsNext(enemies->pools, cap, i)) {
+		unsigned int hash = HASH_PRIME_5;
+		hash = HashFloat(hash, enemies->x[i]);
+		hash = HashFloat(hash, enemies->y[i]);
+		hash = HashFloat(hash, enemies->boundR[i]);
+		hash = HashFloat(hash, enemies->boundL[i]);
+		hash = HashInt(hash, (int)enemies->width[i]); // Whole numbers, hashed as they were when they were ints
+		hash = HashInt(hash, (int)enemies->height[i]);
+		hash = HashInt(hash, enemies->health[i]);
+		hash = HashInt(hash, (int)enemies->detectRange[i]);
+		hash = HashInt(hash, (int)enemies->speed[i]);
+		hash = HashInt(hash, (int)enemies->dir[i]);
+		sum += HashFinish(hash);
+	}
+	return sum;
+}
+
+unsigned int HashPickups(const struct Pickups pickups[], const struct Entity_Pool* pool) {
+	unsigned int sum = 0;
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		unsigned int hash = HASH_PRIME_5;
+		hash = HashFloat(hash, pickups[i].x);
+		hash = HashFloat(hash, pickups[i].y);
+		hash = HashFloat(hash, pickups[i].imageSize);
+		sum += HashFinish(hash);
+	}
+	return sum;
+}
+
+unsigned int HashHazards(const struct Lazer_Hazard lazers[], const struct Entity_Pool* pool) {
+	unsigned int sum = 0;
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		unsigned int hash = HASH_PRIME_5;
+		hash = HashFloat(hash, lazers[i].y);
+		hash = HashFloat(hash, lazers[i].height);
+		hash = HashFloat(hash, lazers[i].timeToFire);
+		hash = HashFloat(hash, lazers[i].timeCreated);
+		sum += HashFinish(hash);
+	}
+	return sum;
+}
+
+unsigned int HashRng(const struct Rng rng[]) {
+	unsigned int hash = HASH_PRIME_5;
+	for (int i = 0; i < MAX_RNG_STREAMS; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			hash = HashInt(hash, (int)(unsigned int)rng[i].state[j]);
+			hash = HashInt(hash, (int)(unsigned int)(rng[i].state[j] >> 32));
+		}
+	}
+	return HashFinish(hash);
+}
+
+#pragma endregion
+
+void HashWorld(const struct GameWorld* world, unsigned int hashes[]) {
+	hashes[WORLD_HASH_GAME] = HashGame(world);
+	hashes[WORLD_HASH_PLAYER] = HashPlayer(&world->player);
+	hashes[WORLD_HASH_PLATFORMS] = HashPlatforms(world);
+	hashes[WORLD_HASH_BULLETS] = HashBullets(world->bullets, &world->bulletPool);
+	hashes[WORLD_HASH_FLYING_ENEMIES] = HashFlyingEnemies(world->flyingEnemies, &world->flyingEnemyPool);
+	hashes[WORLD_HASH_WALKING_ENEMIES] = HashWalkingEnemies(&world->walkingEnemies, world->walkingEnemyCap);
+	hashes[WORLD_HASH_PICKUPS] = HashPickups(world->pickups, &world->pickupPool);
+	hashes[WORLD_HASH_HAZARDS] = HashHazards(world->lazerHazards, &world->lazerHazardPool);
+	hashes[WORLD_HASH_RNG] = HashRng(world->rng);
+}
+
+const char* GetWorldHashName(int part) {
+	switch (part) {
+	case WORLD_HASH_GAME:
+		return "game state";
+	case WORLD_HASH_PLAYER:
+		return "player";
+	case WORLD_HASH_PLATFORMS:
+		return "platforms";
+	case WORLD_HASH_BULLETS:
+		return "bullets";
+	case WORLD_HASH_FLYING_ENEMIES:
+		return "flying enemies";
+	case WORLD_HASH_WALKING_ENEMIES:
+		return "walking enemies";
+	case WORLD_HASH_PICKUPS:
+		return "pickups";
+	case WORLD_HASH_HAZARDS:
+		return "hazards";
+	case WORLD_HASH_RNG:
+		return "random numbers";
+	default:
+		return "unknown";
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: hash.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added World State Hashing
+//
+// brief:
+// Contains the declaration of functions in hash.c.
+// Hashes the world after a step, one hash per part of the world, so a
+// replay played back on changed code can tell where it first went another way.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+enum {
+	// Parts of the World (One hash each)
+	WORLD_HASH_GAME = 0, // Game State, Timers, Camera and Progression
+	WORLD_HASH_PLAYER = 1,
+	WORLD_HASH_PLATFORMS = 2,
+	WORLD_HASH_BULLETS = 3,
+	WORLD_HASH_FLYING_ENEMIES = 4,
+	WORLD_HASH_WALKING_ENEMIES = 5,
+	WORLD_HASH_PICKUPS = 6,
+	WORLD_HASH_HAZARDS = 7,
+	WORLD_HASH_RNG = 8,
+	MAX_WORLD_HASHES = 9,
+};
+
+/// <summary>
+/// Hashes every part of the world. Only gameplay values are hashed, and
+/// only of active entities, in no particular order, so rearranging how the
+/// world is stored does not change the hashes as long as gameplay is the same.
+/// </summary>
+/// <param name="world">Address of Game World</param>
+/// <param name="hashes">Array of size MAX_WORLD_HASHES. This will contain the output</param>
+void HashWorld(const struct GameWorld* world, unsigned int hashes[]);
+
+/// <summary>
+/// Gets the name of a part of the world.
+/// </summary>
+/// <param name="part">WORLD_HASH_*</param>
+/// <returns>Name of the part</returns>
+const char* GetWorldHashName(int part);
@@ -4,6 +4,8 @@
 // authors:
 // l.zheneudamon (primary author)
 //		Added all hazards functions
+//		Changed Lazers to spawn from and go through their Pool
+//		Changed expired Lazers to be tested against the Player in one batch
 //
 // brief:
 // Contains functions used for hazards.
@@ -14,37 +16,67 @@
 // All Content  2023 DigiPen Institute of Technology Singapore, All rights reserved.
 //------------------------------------------------------------------------------------
 
-#include "cprocessing.h"
 #include "initialize.h"
 #include "utils.h"
+#include "pool.h"
+#include "collide.h"
 
-void SpawnLazerHazard(struct Lazer_Hazard lazerHazard[], float timeToFire, float y, float height, float gameTime) {
-	for (int i = 0; i < MAX_LAZER_HAZARDS; ++i) {
-		if (!lazerHazard[i].isActive) {
-			lazerHazard[i].isActive = 1;
-			lazerHazard[i].y = y;
-			lazerHazard[i].height = height;
-			lazerHazard[i].timeToFire = timeToFire;
-			lazerHazard[i].timeCreated = gameTime;
-			break;
-		}
+void SpawnLazerHazard(struct GameWorld* world, float timeToFire, float y, float height) {
+	int i = PoolSpawn(&world->lazerHazardPool, MAX_LAZER_HAZARDS); // Lowest inactive lazer
+	if (i >= 0) {
+		struct Lazer_Hazard* lazerHazard = &world->lazerHazards[i];
+		lazerHazard->y = y;
+		lazerHazard->height = height;
+		lazerHazard->timeToFire = timeToFire;
+		lazerHazard->timeCreated = world->gameTimer;
 	}
 }
 
-int DidLazerHitPlayer(struct Player *player, struct Lazer_Hazard *lazerHazard) { // Run this when lazer timer run out
-	if (AreRectanglesIntersecting(player->x, player->y, player->width, player->height, CP_System_GetWindowWidth() / 2.0f, lazerHazard->y, (float)CP_System_GetWindowWidth(), lazerHazard->height)) {
-		lazerHazard->isActive = 0;
-		player->currentHealth -= 1;
-		return 1;
+int FireExpiredLazers(struct GameWorld* world) { // Run this every frame
+	struct Entity_Pool* pool = &world->lazerHazardPool;
+	struct Lazer_Hazard* lazerHazard = world->lazerHazards;
+	struct Player* player = &world->player;
+	int hits = 0;
+	for (int first = 0; first < MAX_LAZER_HAZARDS; first += COLLIDE_BATCH) {
+		int count = MAX_LAZER_HAZARDS - first < COLLIDE_BATCH ? MAX_LAZER_HAZARDS - first : COLLIDE_BATCH;
+		unsigned int expired = 0;
+		for (unsigned int live = PoolsBits(pool, first, count), k = 0; live; ++k, live >>= 1) {
+			int i = first + k;
+			if ((live & 1) && lazerHazard[i].timeCreated + lazerHazard[i].timeToFire < world->gameTimer) {
+				expired |= 1u << k;
+			}
+		}
+		if (!expired) {
+			continue;
+		}
+		count = CollideCount(expired); // Up to the last lazer fired
+		float xs[COLLIDE_BATCH], ys[COLLIDE_BATCH], widths[COLLIDE_BATCH], heights[COLLIDE_BATCH];
+		for (int k = 0; k < count; ++k) { // Lazers not fired are tested too, their bits are left out
+			xs[k] = WINDOW_WIDTH / 2.0f; // Lazers go across the whole screen
+			ys[k] = lazerHazard[first + k].y;
+			widths[k] = (float)WINDOW_WIDTH;
+			heights[k] = lazerHazard[first + k].height;
+		}
+		unsigned int hit = RectHitsRects(player->x, player->y, player->width, player->height, xs, ys, widths, heights, count) & expired;
+		for (int k = 0; expired; ++k, expired >>= 1, hit >>= 1) {
+			if (expired & 1) {
+				PoolDespawn(pool, first + k);
+			}
+			if (hit & 1) {
+				player->currentHealth -= 1;
+				hits++;
+			}
+		}
 	}
-	lazerHazard->isActive = 0;
-	return 0;
+	return hits;
 }
 
-void DespawnLazerHazard(struct Lazer_Hazard lazerHazard[], float maxY) { // Run this every frame to remove hazards outside screen
-	for (int i = 0; i < MAX_LAZER_HAZARDS; ++i) {
-		if (lazerHazard[i].isActive && lazerHazard[i].y < maxY - CP_System_GetWindowHeight()) {
-			lazerHazard[i].isActive = 0;
+void DespawnLazerHazard(struct GameWorld* world) { // Run this every frame to remove hazards outside screen
+	struct Entity_Pool* pool = &world->lazerHazardPool;
+	struct Lazer_Hazard* lazerHazard = world->lazerHazards;
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		if (lazerHazard[i].y < world->maxY - WINDOW_HEIGHT) {
+			PoolDespawn(pool, i);
 		}
 	}
 }
\ No newline at end of file
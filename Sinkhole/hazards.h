@@ -5,6 +5,8 @@
 // authors:
 // l.zheneudamon (primary author)
 //		Added declarations
+//		Changed DidLazerHitPlayer to take the slot of the Lazer
+//		Changed DidLazerHitPlayer to FireExpiredLazers, testing every Lazer in one batch
 //
 // brief:
 // Contains declaration of functions used in hazards.c.
@@ -18,24 +20,21 @@
 /// <summary>
 /// Spawns a Lazer Hazard.
 /// </summary>
-/// <param name="lazerHazard">Array of Lazer Hazards</param>
+/// <param name="world">Address of Game World</param>
 /// <param name="timeToFire">Time it takes for Lazer To Fire</param>
 /// <param name="y">Center of Lazer's Y Value</param>
 /// <param name="height">Height of Lazer</param>
-/// <param name="gameTime">Current Game Time</param>
-void SpawnLazerHazard(struct Lazer_Hazard lazerHazard[], float timeToFire, float y, float height, float gameTime);
+void SpawnLazerHazard(struct GameWorld* world, float timeToFire, float y, float height);
 
 /// <summary>
-/// Checks if the Lazer hit the player.
+/// Fires the Lazers whose timer ran out, they are despawned. Each that hits the player takes 1 health.
 /// </summary>
-/// <param name="player">Address of Player</param>
-/// <param name="lazerHazard">Address of Expired Lazer Hazard</param>
-/// <returns>1 if lazer hits, 0 if lazer didn't hit</returns>
-int DidLazerHitPlayer(struct Player* player, struct Lazer_Hazard* lazerHazard);
+/// <param name="world">Address of Game World</param>
+/// <returns>Number of lazers that hit</returns>
+int FireExpiredLazers(struct GameWorld* world);
 
 /// <summary>
 /// Removes Lazers that are outside of the Screen.
 /// </summary>
-/// <param name="lazerHazard">Array of Lazer Hazards</param>
-/// <param name="maxY">Center Point of Camera</param>
-void DespawnLazerHazard(struct Lazer_Hazard lazerHazard[], float maxY);
+/// <param name="world">Address of Game World</param>
+void DespawnLazerHazard(struct GameWorld* world);
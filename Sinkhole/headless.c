@@ -0,0 +1,488 @@
+//------------------------------------------------------------------------------------
+// file: headless.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Headless Runner with a scripted bot
+//		Added Replay Recording and Playback
+//		Added Replay Seeking
+//		Added Replay Checker
+//		Added Agent Bot (plays through the Agent API)
+//		Added Walking Enemy Stress Test
+//		Added Collision Test Check
+//		Added Lookahead to the Replay Checker
+//		Added Timing of Observing to the Agent Bot
+//
+// brief:
+// Runs the simulation without a window, graphics or sounds.
+// A simple bot (bot.c) plays the game so the simulation can be benchmarked
+// (and later tested) on any platform with a C compiler.
+// Not part of the Visual Studio build, see README.md for the command line.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "initialize.h"
+#include "agent.h"
+#include "bot.h"
+#include "collide.h"
+#include "enemy.h"
+#include "hash.h"
+#include "platforms.h"
+#include "replay.h"
+#include "sim.h"
+#include "utils.h"
+
+/// <summary>
+/// Plays back a replay as fast as possible and prints where the run ended.
+/// </summary>
+/// <param name="path">Replay File</param>
+/// <param name="seekSeconds">Seeks here first and prints the world there, negative to not seek</param>
+/// <returns>Exit Code</returns>
+int PlayReplay(const char* path, float seekSeconds) {
+	struct Replay replay = { 0 };
+	if (!Replay_Load(&replay, path)) {
+		printf("could not read replay: %s\n", path);
+		return 1;
+	}
+
+	struct GameWorld world;
+	struct Sim_Input input;
+	Sim_Init(&world, replay.seed);
+
+	if (seekSeconds >= 0) {
+		clock_t seekStart = clock();
+		long step = Replay_Seek(&replay, &world, (long)(seekSeconds * SIM_STEPS_PER_SECOND));
+		double seekTime = (double)(clock() - seekStart) / CLOCKS_PER_SEC;
+		printf("seeked: step: %ld, depth: %d, kills: %d, health: %d, time: %.3fms\n", step, (int)world.maxY - 347, world.player.killCount, world.player.currentHealth, seekTime * 1000);
+	}
+
+	float dt = 1.0f / SIM_STEPS_PER_SECOND;
+	long steps = 0;
+	clock_t start = clock();
+	while (Replay_ReadStep(&replay, &input)) {
+		Sim_Step(&world, &input, dt);
+		steps++;
+	}
+
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	printf("seed: %llu, steps: %ld, depth: %d, kills: %d, health: %d\n", replay.seed, replay.stepsRead, (int)world.maxY - 347, world.player.killCount, world.player.currentHealth);
+	printf("time: %.3fs, steps/sec: %.0f\n", seconds, seconds > 0 ? steps / seconds : 0.0);
+	Replay_Free(&replay);
+	return 0;
+}
+
+/// <summary>
+/// Plays back a replay and compares the world after every step with the
+/// hashes recorded with it. Prints the first step that differs, and which
+/// parts of the world differ there.
+/// </summary>
+/// <param name="path">Replay File</param>
+/// <param name="lookahead">Rows of platforms to generate ahead, the hashes match with any number</param>
+/// <returns>0 if the whole replay matches, else 1</returns>
+int CheckReplay(const char* path, int lookahead) {
+	struct Replay replay = { 0 };
+	if (!Replay_Load(&replay, path)) {
+		printf("%s: could not read replay\n", path);
+		return 1;
+	}
+
+	struct GameWorld world;
+	struct Sim_Input input;
+	Sim_Init(&world, replay.seed);
+	SetPlatformLookahead(&world, lookahead);
+
+	float dt = 1.0f / SIM_STEPS_PER_SECOND;
+	int differs = 0;
+	while (differs == 0 && Replay_ReadStep(&replay, &input)) {
+		Sim_Step(&world, &input, dt);
+		differs = Replay_CheckHash(&replay, replay.stepsRead - 1, &world);
+	}
+
+	if (differs < 0) {
+		printf("%s: no hashes recorded\n", path);
+	} else if (differs > 0) {
+		long step = replay.stepsRead - 1;
+		printf("%s: differs at step %ld (%.2fs):", path, step, (float)step / SIM_STEPS_PER_SECOND);
+		for (int i = 0; i < MAX_WORLD_HASHES; ++i) {
+			if (differs & (1 << i)) {
+				printf(" %s", GetWorldHashName(i));
+			}
+		}
+		printf("\n");
+	} else {
+		printf("%s: matches, %ld steps\n", path, replay.stepsRead);
+	}
+	Replay_Free(&replay);
+	return differs != 0;
+}
+
+/// <summary>
+/// Bot that only sees the observation, like a learned bot would.
+/// Walks towards the closest gap of the row below and shoots the closest enemy.
+/// </summary>
+/// <param name="observation">Array of size AGENT_OBSERVATION_SIZE</param>
+/// <param name="action">Address of Action to fill in</param>
+void AgentBot(const float observation[], struct Agent_Action* action) {
+	const float* player = &observation[AGENT_OBSERVATION_PLAYER];
+	memset(action, 0, sizeof(*action));
+	if (player[8]) { // Choosing an upgrade, pick in rotation
+		action->upgrade = 1 + (int)player[9] % 3;
+		return;
+	}
+
+	float x = (player[0] + 1) / 2; // In window widths
+	float target = x;
+	const float* row = &observation[AGENT_OBSERVATION_ROWS];
+	if (row[0] > 0) {
+		float edges[AGENT_ROW_FEATURES + 1] = { 0.2f }; // Walls are a fifth of the window wide
+		int edgeCount = 1;
+		for (int p = 1; p < AGENT_ROW_FEATURES; p += 2) {
+			if (row[p + 1] > row[p]) {
+				edges[edgeCount++] = row[p];
+				edges[edgeCount++] = row[p + 1];
+			}
+		}
+		edges[edgeCount++] = 0.8f;
+
+		float closest = 1;
+		for (int i = 0; i + 1 < edgeCount; i += 2) { // Even edges open a gap, odd edges close it
+			float center = (edges[i] + edges[i + 1]) / 2;
+			float distance = center > x ? center - x : x - center;
+			if (edges[i + 1] - edges[i] > 0.03f && distance < closest) {
+				closest = distance;
+				target = center;
+			}
+		}
+	}
+	action->move = target > x + 0.006f ? 1 : target < x - 0.006f ? -1 : 0;
+
+	const float* enemy = &observation[AGENT_OBSERVATION_ENEMIES];
+	action->shoot = enemy[0] > 0;
+	action->aimX = enemy[1];
+	action->aimY = enemy[2];
+}
+
+/// <summary>
+/// Plays the actions through the Agent API twice, a chunk of them at a time: once
+/// observing after every step and once not, from the same Agent both times, so
+/// both are timed on the same worlds while the machine is under the same load.
+/// Runs start over like in PlayAgent.
+/// </summary>
+/// <param name="actions">Array of Actions, one per Agent_Step</param>
+/// <param name="count">Actions in the array</param>
+/// <param name="seed">Seed of the first run</param>
+/// <param name="actionRepeat">Steps each action is played for</param>
+/// <returns>Time observing adds on top of the steps, in percent</returns>
+double TimeObserving(const struct Agent_Action actions[], long count, unsigned long long seed, int actionRepeat) {
+	struct Agent agent, chunkAgent;
+	float observation[AGENT_OBSERVATION_SIZE];
+	Agent_Reset(&agent, seed, observation);
+	agent.actionRepeat = actionRepeat;
+
+	long chunk = 1 << 16; // Actions timed at a time, long enough for the clock
+	int runs = 1, chunkRuns;
+	double observed = 0, stepped = 0;
+	for (long first = 0; first < count; first += chunk) {
+		long last = first + chunk < count ? first + chunk : count;
+		chunkAgent = agent;
+		chunkRuns = runs;
+		for (int pass = 0; pass < 2; ++pass) {
+			int isObserving = pass == (int)(first / chunk % 2); // Which goes first swaps every chunk, the second starts with warmer caches
+			agent = chunkAgent;
+			runs = chunkRuns;
+			clock_t start = clock();
+			for (long i = first; i < last; ++i) {
+				if (Agent_Step(&agent, &actions[i], isObserving ? observation : NULL, NULL)) {
+					Agent_Reset(&agent, seed ^ ((unsigned long long)runs << 32), observation);
+					agent.actionRepeat = actionRepeat;
+					runs++;
+				}
+			}
+			double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+			observed += isObserving ? seconds : 0;
+			stepped += isObserving ? 0 : seconds;
+		}
+	}
+	return stepped > 0 ? 100 * (observed - stepped) / stepped : 0.0;
+}
+
+/// <summary>
+/// Plays like the main loop, but through the Agent API, to test it and to
+/// see what observing costs on top of the step (the actions are played again
+/// with TimeObserving).
+/// </summary>
+/// <param name="steps">Steps to play</param>
+/// <param name="seed">Seed of the first run</param>
+/// <param name="actionRepeat">Steps each action is played for</param>
+/// <returns>Exit Code</returns>
+int PlayAgent(long steps, unsigned long long seed, int actionRepeat) {
+	struct Agent agent;
+	struct Agent_Action action;
+	float observation[AGENT_OBSERVATION_SIZE];
+	Agent_Reset(&agent, seed, observation);
+	agent.actionRepeat = actionRepeat;
+	struct Agent_Action* actions = malloc(sizeof(struct Agent_Action) * steps); // Each action plays at least one step
+	long actionCount = 0;
+
+	int runs = 1;
+	long step = 0;
+	float deepest = 0, reward = 0;
+	clock_t start = clock();
+	while (step < steps) {
+		AgentBot(observation, &action);
+		if (actions != NULL) {
+			actions[actionCount++] = action;
+		}
+		long runSteps = agent.steps;
+		float stepReward;
+		int isOver = Agent_Step(&agent, &action, observation, &stepReward);
+		step += agent.steps - runSteps;
+		reward += stepReward;
+		if (isOver) {
+			deepest = agent.world.maxY > deepest ? agent.world.maxY : deepest;
+			Agent_Reset(&agent, seed ^ ((unsigned long long)runs << 32), observation);
+			agent.actionRepeat = actionRepeat;
+			runs++;
+		}
+	}
+
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	deepest = agent.world.maxY > deepest ? agent.world.maxY : deepest;
+	printf("steps: %ld, runs: %d, deepest: %d, rows gone down: %.0f\n", step, runs, (int)deepest - 347, reward);
+	printf("time: %.3fs, steps/sec: %.0f\n", seconds, seconds > 0 ? step / seconds : 0.0);
+
+	if (actions != NULL) {
+		printf("observing: %.1f%% on top of the step\n", TimeObserving(actions, actionCount, seed, actionRepeat));
+		free(actions);
+	}
+	return 0;
+}
+
+/// <summary>
+/// Random value for the collision check. Mostly on a grid of quarters, so
+/// shapes often touch exactly at an edge, some a float step off the grid,
+/// and some anywhere.
+/// </summary>
+/// <param name="rng">Random Number Stream</param>
+/// <param name="min">Min value, in quarters</param>
+/// <param name="max">Max value, in quarters</param>
+/// <returns>Value between min / 4 and max / 4</returns>
+float CollideValue(struct Rng* rng, int min, int max) {
+	float value = RandomNumber(rng, min, max) * 0.25f;
+	switch (RandomNumber(rng, 0, 3)) {
+	case 0:
+		return nextafterf(value, value + 1);
+	case 1:
+		return nextafterf(value, value - 1);
+	case 2:
+		return RandomNumber(rng, min * 1000, max * 1000) / 4000.0f;
+	default:
+		return value;
+	}
+}
+
+/// <summary>
+/// Checks every batched test of collide.c against its function in utils.c
+/// called on each shape, and prints how many random cases give the same bits.
+/// </summary>
+/// <param name="cases">Number of random cases</param>
+/// <param name="seed">Seed of the cases</param>
+/// <returns>0 if every case matches, else 1</returns>
+int CheckCollide(int cases, unsigned long long seed) {
+	struct Rng rng;
+	SeedRandom(&rng, seed, 0);
+	int differs = 0;
+	for (int c = 0; c < cases; ++c) {
+		int count = RandomNumber(&rng, 1, COLLIDE_BATCH);
+		int test = c % 6; // Each test gets the same share of cases
+		float x = CollideValue(&rng, -40, 40), y = CollideValue(&rng, -40, 40);
+		float width = CollideValue(&rng, 0, 40), height = CollideValue(&rng, 0, 40);
+		float top = CollideValue(&rng, -40, 40), bottom = top + height; // Edges of the platform row
+		float xs[COLLIDE_BATCH], ys[COLLIDE_BATCH], widths[COLLIDE_BATCH], heights[COLLIDE_BATCH], rights[COLLIDE_BATCH];
+		for (int k = 0; k < count; ++k) {
+			xs[k] = CollideValue(&rng, -40, 40);
+			ys[k] = CollideValue(&rng, -40, 40);
+			widths[k] = CollideValue(&rng, 0, 40);
+			heights[k] = CollideValue(&rng, 0, 40);
+			rights[k] = xs[k] + widths[k];
+		}
+
+		unsigned int batched = 0, single = 0;
+		switch (test) {
+		case 0:
+			batched = CircleHitsPoints(x, y, width, xs, ys, count);
+			break;
+		case 1:
+			batched = CircleHitsCircles(x, y, width, xs, ys, widths, count);
+			break;
+		case 2:
+			batched = CircleHitsRects(x, y, width, xs, ys, widths, heights, count);
+			break;
+		case 3:
+			batched = CirclesHitRect(xs, ys, widths, x, y, width, height, count);
+			break;
+		case 4: // xs are the left edges of the segments
+			batched = CircleHitsSegments(x, y, width, xs, rights, top, bottom, count);
+			break;
+		default:
+			batched = RectHitsRects(x, y, width, height, xs, ys, widths, heights, count);
+			break;
+		}
+		for (int k = 0; k < count; ++k) {
+			int hit;
+			switch (test) {
+			case 0:
+				hit = IsCircleClicked(x, y, width, xs[k], ys[k]);
+				break;
+			case 1:
+				hit = AreCirclesIntersecting(x, y, width, xs[k], ys[k], widths[k]);
+				break;
+			case 2:
+				hit = IsCircleAndRectIntersecting(x, y, width, xs[k], ys[k], widths[k], heights[k]);
+				break;
+			case 3:
+				hit = IsCircleAndRectIntersecting(xs[k], ys[k], widths[k], x, y, width, height);
+				break;
+			case 4:
+				hit = IsCircleAndEdgesIntersecting(x, y, width, xs[k], top, rights[k], bottom);
+				break;
+			default:
+				hit = AreRectanglesIntersecting(x, y, width, height, xs[k], ys[k], widths[k], heights[k]);
+				break;
+			}
+			single |= (unsigned int)(hit != 0) << k;
+		}
+		if (batched != single) {
+			if (differs == 0) {
+				printf("case %d (test %d, %d shapes): batched %08x, one at a time %08x\n", c, test, count, batched, single);
+			}
+			differs++;
+		}
+	}
+	printf("%d of %d cases match\n", cases - differs, cases);
+	return differs > 0;
+}
+
+int main(int argc, char* argv[]) {
+	long steps = 100000;
+	unsigned long long seed = 1;
+	const char* recordFile = NULL;
+	const char* replayFile = NULL;
+	float seekSeconds = -1;
+	int checks = 0, failedChecks = 0;
+	int isAgent = 0;
+	int actionRepeat = AGENT_ACTION_REPEAT;
+	int lookahead = 0;
+	int stressWalkers = 0;
+	int collideCases = 0;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "-steps") == 0) {
+			steps = atol(argv[i + 1]);
+		} else if (strcmp(argv[i], "-seed") == 0) {
+			seed = strtoull(argv[i + 1], NULL, 10);
+		} else if (strcmp(argv[i], "-record") == 0) { // Records the first run
+			recordFile = argv[i + 1];
+		} else if (strcmp(argv[i], "-replay") == 0) {
+			replayFile = argv[i + 1];
+		} else if (strcmp(argv[i], "-seek") == 0) { // Seconds into the replay
+			seekSeconds = (float)atof(argv[i + 1]);
+		} else if (strcmp(argv[i], "-bot") == 0) { // "script" (bot.c, the default) or "agent" (AgentBot)
+			isAgent = strcmp(argv[i + 1], "agent") == 0;
+		} else if (strcmp(argv[i], "-repeat") == 0) { // Steps each action of the agent bot is played for
+			actionRepeat = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-lookahead") == 0) { // Rows of platforms generated ahead of the player
+			lookahead = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-stress") == 0) { // Walking enemies kept alive, every free slot is filled each step
+			stressWalkers = atoi(argv[i + 1]);
+		} else if (strcmp(argv[i], "-collide") == 0) { // Random cases of the batched collision tests to check
+			collideCases = atoi(argv[i + 1]);
+		}
+	}
+	for (int i = 1; i + 1 < argc; i += 2) { // After the rest, so -lookahead applies wherever it was given
+		if (strcmp(argv[i], "-check") == 0) { // Can be given more than once
+			failedChecks += CheckReplay(argv[i + 1], lookahead);
+			checks++;
+		}
+	}
+	if (checks > 0) {
+		printf("%d of %d replays match\n", checks - failedChecks, checks);
+		return failedChecks > 0;
+	}
+	if (collideCases > 0) {
+		return CheckCollide(collideCases, seed);
+	}
+	if (replayFile != NULL) {
+		return PlayReplay(replayFile, seekSeconds);
+	}
+	if (isAgent) {
+		return PlayAgent(steps, seed, actionRepeat);
+	}
+
+	if (recordFile != NULL && stressWalkers > 0) {
+		printf("runs with -stress can not be recorded, replays do not spawn the extra walking enemies\n");
+		return 1;
+	}
+
+	struct GameWorld world;
+	struct Sim_Input input;
+	Sim_Init(&world, seed);
+	SetPlatformLookahead(&world, lookahead);
+	if (stressWalkers > WALKING_ENEMY_CAPACITY) {
+		printf("only %d walking enemies fit, build with -DWALKING_ENEMY_STRESS for more\n", WALKING_ENEMY_CAPACITY);
+	}
+	if (stressWalkers > 0) {
+		SetWalkingEnemyCap(&world, stressWalkers);
+	}
+	struct Replay replay = { 0 };
+	Replay_StartRecording(&replay, seed);
+
+	float dt = 1.0f / SIM_STEPS_PER_SECOND;
+	int runs = 1;
+	float deepest = 0;
+	clock_t start = clock();
+
+	for (long step = 0; step < steps; ++step) {
+		if (stressWalkers > 0) {
+			StressSpawningWalking(&world);
+		}
+		BotInput(&world, &input);
+		if (recordFile != NULL && runs == 1) {
+			Replay_RecordStep(&replay, &world, &input);
+		}
+		Sim_Step(&world, &input, dt);
+		if (recordFile != NULL && runs == 1) {
+			Replay_RecordHash(&replay, &world);
+		}
+		if (world.gameState == GAME_STATE_DEFEAT) { // Restart straight away
+			if (recordFile != NULL && runs == 1) {
+				printf("recorded: seed: %llu, steps: %ld, depth: %d, kills: %d, health: %d\n", replay.seed, replay.steps, (int)world.maxY - 347, world.player.killCount, world.player.currentHealth);
+			}
+			deepest = world.maxY > deepest ? world.maxY : deepest;
+			Sim_Init(&world, seed ^ ((unsigned long long)runs << 32)); // Each run gets its own seed, runs of nearby seeds don't overlap
+			SetPlatformLookahead(&world, lookahead);
+			if (stressWalkers > 0) {
+				SetWalkingEnemyCap(&world, stressWalkers);
+			}
+			runs++;
+		}
+	}
+
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	if (recordFile != NULL && !Replay_Save(&replay, recordFile)) {
+		printf("could not write replay: %s\n", recordFile);
+	}
+	Replay_Free(&replay);
+	deepest = world.maxY > deepest ? world.maxY : deepest;
+	printf("steps: %ld, runs: %d, deepest: %d\n", steps, runs, (int)deepest - 347);
+	printf("time: %.3fs, steps/sec: %.0f\n", seconds, seconds > 0 ? steps / seconds : 0.0);
+	return 0;
+}
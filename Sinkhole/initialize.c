@@ -5,6 +5,9 @@
 // l.zheneudamon (primary author)
 //		Added Initialization for
 //		Player, Game State Upgrade, Game State Defeat, Pickups, Lazer Hazards
+//		Difficulty
+//		Changed entity Initialization to also free the slots of their Pool
+//		Changed Walking Enemy Initialization to the structure of arrays
 // tituswenshuen.kwong
 //		Added Initialising function for
 //		Flying Enemy, Bullet
@@ -24,15 +27,16 @@
 
 #include <math.h>
 #include <stdio.h>
-#include "cprocessing.h"
+#include <string.h>
 #include "initialize.h"
+#include "pool.h"
 
 void InitializePlayer(struct Player* p) {
-	p->imageAddress = NULL;
-	p->width = 2 * CP_System_GetWindowWidth() / 100.0f; // 0.02 of Window_Width
+	p->animation = PLAYER_ANIMATION_FALL;
+	p->width = 2 * WINDOW_WIDTH / 100.0f; // 0.02 of Window_Width
 	p->height = p->width * 3; // 0.06 of Window_Width
-	p->x = CP_System_GetWindowWidth() / 2.0f;
-	p->y = CP_System_GetWindowHeight() / 2.0f - 100;
+	p->x = WINDOW_WIDTH / 2.0f;
+	p->y = WINDOW_HEIGHT / 2.0f - 100;
 	p->horizontalVelocity = 0;
 	p->verticalVelocity = 0;
 	p->movementSpeed = 150;
@@ -55,7 +59,7 @@ void InitializeGameStateUpgrade(struct Game_State_Upgrade *p, float playerX) {
 	p->isUpgradeChosen = 0;
 	p->secondsSinceState = 0;
 	p->secondsSinceUpgradeChosen = 0;
-	p->distanceToCenter = playerX - CP_System_GetWindowWidth() / 2.0f;
+	p->distanceToCenter = playerX - WINDOW_WIDTH / 2.0f;
 	for (int i = 0; i < 3; ++i) {
 		p->upgradeChoice[i] = 0;
 	}
@@ -65,55 +69,75 @@ void InitializeGameStateDefeat(struct Game_State_Defeat *p) {
 	p->secondsSinceState = 0;
 }
 
-void InitializeBullets(struct Bullet bullets[]) {
+void InitializeBullets(struct Bullet bullets[], struct Entity_Pool* pool) {
+	PoolClear(pool); // Sets all Bullets to Inactive
 	for (int i = 0; i < MAX_BULLETS; ++i) {
-		bullets[i].isActive = 0; // Sets all Bullets to Inactive
+		bullets[i].x = 0;
+		bullets[i].y = 0;
+		bullets[i].velocity = 0;
+		bullets[i].diameterSize = 0;
+		bullets[i].distanceTraveled = 0;
+		bullets[i].directionX = 0;
+		bullets[i].directionY = 0;
 	}
 }
 
-void InitializeWalkingEnemies(struct Walking_Enemy enemies[]) {
-	for (int i = 0; i < MAX_WALKING_ENEMIES; ++i) {
-		enemies[i].x = 0; 
-		enemies[i].y = 0;
-		enemies[i].isActive = 0;
-		enemies[i].boundL = 0;
-		enemies[i].boundR = 0;
-		enemies[i].width = 0;
-		enemies[i].height = 0;
-		enemies[i].health = 0;
-		enemies[i].dir = 0;
-		enemies[i].speed = 0;
-		enemies[i].detectRange = 0;
-	}
+void InitializeWalkingEnemies(struct Walking_Enemies* enemies) {
+	memset(enemies, 0, sizeof(*enemies)); // Every value of every slot, and frees every slot
 }
 
-void InitializeFlyingEnemies(struct Flying_Enemy enemies[]) {
+void InitializeFlyingEnemies(struct Flying_Enemy enemies[], struct Entity_Pool* pool) {
+	PoolClear(pool);
 	for (int i = 0; i < MAX_FLYING_ENEMIES; ++i) {
 		enemies[i].x = 0;
 		enemies[i].y = 0;
-		enemies[i].isActive = 0;
 		enemies[i].diameter = 0;
 		enemies[i].enemySpeed = 0;
 		enemies[i].enemyHealth = 0;
 	}
 }
 
-void InitializePickups(struct Pickups pickup[]) {
+void InitializePickups(struct Pickups pickup[], struct Entity_Pool* pool) {
+	PoolClear(pool);
 	for (int i = 0; i < MAX_HEALTH_PICKUPS; ++i) {
 		pickup[i].x = 0;
 		pickup[i].y = 0;
-		pickup[i].isActive = 0;
 		pickup[i].imageSize = 0;
-		pickup[i].imageAddress = NULL;
 	}
 }
 
-void InitializeLazerHazard(struct Lazer_Hazard lazerHazards[]) {
+void InitializeLazerHazard(struct Lazer_Hazard lazerHazards[], struct Entity_Pool* pool) {
+	PoolClear(pool);
 	for (int i = 0; i < MAX_LAZER_HAZARDS; ++i) {
 		lazerHazards[i].y = 0;
 		lazerHazards[i].height = 0;
-		lazerHazards[i].isActive = 0;
 		lazerHazards[i].timeToFire = 0;
 		lazerHazards[i].timeCreated = 0;
 	}
 }
+
+void InitializeDifficulty(struct Difficulty* d) {
+	d->minSpawnPercentage = DIFFICULTY_MIN_SPAWN_PERCENTAGE_MODIFIER;
+	d->maxSpawnPercentage = DIFFICULTY_MAX_SPAWN_PERCENTAGE_MODIFIER;
+	d->spawnPercentageIncrement = DIFFICULTY_SPAWN_PERCENTAGE_INCREMENT_MODIFIER;
+	d->minWalkingEnemies = DIFFICULTY_MIN_WALKING_ENEMIES;
+	d->maxWalkingEnemies = DIFFICULTY_MAX_WALKING_ENEMIES;
+	d->minWalkingEnemiesHealth = DIFFICULTY_MIN_WALKING_ENEMIES_HEALTH;
+	d->walkingEnemiesHealthIncrement = DIFFICULTY_HEALTH_INCREMENT_WALKING_ENEMIES_MODIFIER;
+	d->minWalkingEnemiesSpeed = DIFFICULTY_MIN_WALKING_ENEMIES_SPEED;
+	d->walkingEnemiesSpeedIncrement = DIFFICULTY_SPEED_INCREMENT_WALKING_ENEMIES_MODIFIER;
+
+	d->flyingEnemiesSpawnTime = DIFFICULTY_FLYING_ENEMIES_SPAWN_TIME;
+	d->minFlyingEnemiesHealth = DIFFICULTY_MIN_FLYING_ENEMIES_HEALTH;
+	d->flyingEnemiesHealthIncrement = DIFFICULTY_HEALTH_INCREMENT_FLYING_ENEMIES_MODIFIER;
+	d->minFlyingEnemiesSpeed = DIFFICULTY_MIN_FLYING_ENEMIES_SPEED;
+	d->flyingEnemiesSpeedIncrement = DIFFICULTY_SPEED_INCREMENT_FLYING_ENEMIES_MODIFIER;
+
+	d->minHazardTimeToFire = DIFFICULTY_MIN_HAZARD_TIME_TO_FIRE_MODIFIER;
+	d->maxHazardTimeToFire = DIFFICULTY_MAX_HAZARD_TIME_TO_FIRE_MODIFIER;
+	d->minHazardHeight = DIFFICULTY_MIN_HAZARD_HEIGHT_MODIFIER;
+	d->maxHazardHeight = DIFFICULTY_MAX_HAZARD_HEIGHT_MODIFIER;
+	d->hazardHeightIncrement = DIFFICULTY_HAZARD_HEIGHT_INCREMENT_MODIFIER;
+	d->minHazardSpawnTime = DIFFICULTY_MIN_HAZARD_SPAWN_TIME;
+	d->maxHazardSpawnTime = DIFFICULTY_MAX_HAZARD_SPAWN_TIME;
+}
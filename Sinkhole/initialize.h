@@ -6,6 +6,14 @@
 // l.zheneudamon (primary author)
 //		Added Structs for 
 //		Player, Lazer, Upgrades, Pickups, Game State Upgrade, Game State Defeat
+//		Changed Platform Struct to a sorted array of segments
+//		Changed Platforms array to a ring buffer with lookahead rows
+//		Changed Platform Struct to a cache line of precomputed edges
+//		Added Platform Queue Struct, rows built ahead with their walking enemy spawns
+//		Added Entity Pool Struct, replacing isActive of pooled entities
+//		Changed Walking Enemy Struct to a structure of arrays
+//		Changed the stress test walking enemy capacity to a build option
+//		Added World Layout Version, checked by replays before restoring keyframes
 // timo.duethorn
 //		Added Platform Struct
 // tituswenshuen.kwong
@@ -22,6 +30,7 @@
 // brief:
 // Contains function declaration of functions in initialize.c.
 // Also contains structs used throughout the project files.
+// Nothing in here depends on CProcessing, so the simulation can be built headless.
 //
 // documentation link:
 // https://github.com/gwong-dp/c_processing/wiki
@@ -29,8 +38,6 @@
 // All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
 //------------------------------------------------------------------------------------
 
-#include <cprocessing.h>
-
 enum {
 	// Game States
 	GAME_STATE_PLAYING = 1,
@@ -38,8 +45,17 @@ enum {
 	GAME_STATE_DEFEAT = 3,
 	GAME_STATE_PAUSE = 4,
 
+	// Window Size (Set in main.c, the simulation uses these instead of CP_System_GetWindowWidth/Height)
+	WINDOW_WIDTH = 1600,
+	WINDOW_HEIGHT = 900,
+
+	// Add 1 whenever struct GameWorld (or anything in it) changes, or a seed plays out different platforms.
+	// Replays store it, and are not loaded by a game with another layout (see replay.h)
+	WORLD_LAYOUT_VERSION = 1,
+
 	GRAVITY = 600,
-	TERMINAL_VELOCITY = 100,
+	TERMINAL_VELOCITY = 6000, // Pixels per second (100 pixels per frame at 60 FPS)
+	ENEMY_SPEED_FRAME_RATE = 60, // Enemy speeds are tuned as pixels per frame at this frame rate
 	FIRST_UPGRADE_Y_VALUE = 2000, // First Upgrade is at Y 2000
 	NEXT_UPGRADE_Y_VALUE = 5000, // Next Upgrade is Y 2000 + Y 5000 * numberOfUpgrades
 	FALLING_Y_VALUE = 1000, // Fall for this distance after getting an upgrade
@@ -48,12 +64,24 @@ enum {
 	MAX_UPGRADE_NAME = 128,
 	MAX_UPGRADE_TEXT = 256,
 	MAX_BULLETS = 20,
-	MAX_PLATFORMS = 6,
+	MAX_PLATFORMS = 16, // Rows the platform ring buffer can hold, must be a power of two
+	PLATFORM_WINDOW_ROWS = 6, // Rows kept around the player, more are added below with SetPlatformLookahead
+	PLATFORM_QUEUE_ROWS = 4, // Rows built ahead in the Platform Queue, must be a power of two
+	PLATFORM_SPAWN_SLOTS = 7, // Most walking enemies one row has spawn rolls for
+	MAX_PLATFORM_SEGMENTS = 4, // Solid pieces one row can hold
+	CACHE_LINE_SIZE = 64, // Bytes, CACHE_ALIGNED has to match
+	POOL_CAPACITY = 64, // Most slots an Entity_Pool keeps track of, one bit each
 	MAX_SCORE_DIGITS = 20, // Highscore wont be more than 10^19
 	MAX_KILLS_DIGITS = 7, // Kills wont be more than 10^6
 	MAX_HEALTH_PICKUPS = 5, // No more than 5 health pickups in the screen at anypoint of time
 	MAX_LAZER_HAZARDS = 10, // No more than 10 lazer hazards at anypoint of time
 	MAX_WALKING_ENEMIES = 50, // No more than 50 walking enemies in the screen at anypoint of time
+#ifdef WALKING_ENEMY_STRESS
+	WALKING_ENEMY_CAPACITY = 2048, // Walking enemy slots of a world, for the headless runner's -stress. Only MAX_WALKING_ENEMIES are used unless raised with SetWalkingEnemyCap
+#else
+	WALKING_ENEMY_CAPACITY = POOL_CAPACITY, // Walking enemy slots of a world, room for MAX_WALKING_ENEMIES. Build with -DWALKING_ENEMY_STRESS for 2048
+#endif
+	WALKING_ENEMY_POOLS = WALKING_ENEMY_CAPACITY / POOL_CAPACITY,
 	MAX_FLYING_ENEMIES = 10, // No more than 10 flying enemies at anypoint of time
 
 	// Number of frame for animations
@@ -82,8 +110,9 @@ enum {
 	UPGRADE_PROJECTILESIZE_INCREMENT = 30,
 	UPGRADE_PROJECTILESPEED_INCREMENT = 200,
 
-	// Difficulty Increments
+	// Difficulty Increments (Defaults of struct Difficulty, see balance.c for tuning them)
 	DIFFICULTY_MAX_FLYING_ENEMIES = 5, // In Map
+	DIFFICULTY_FLYING_ENEMIES_SPAWN_TIME = 4, // Seconds between Flying Enemies
 	DIFFICULTY_HEALTH_INCREMENT_FLYING_ENEMIES_MODIFIER = 5,
 	DIFFICULTY_MIN_FLYING_ENEMIES_HEALTH = 10,
 	DIFFICULTY_SPEED_INCREMENT_FLYING_ENEMIES_MODIFIER = 2,
@@ -111,11 +140,64 @@ enum {
 	PICKUP_DROP_CHANCE = 5,
 	PICKUP_SIZE = 50,
 
+	// Random Number Streams (Each system draws from its own, so one system drawing more doesn't shift the others)
+	RNG_STREAM_PLATFORMS = 0, // Each row seeds its own with SeedRandomAt, keyed by its y
+	RNG_STREAM_ENEMIES = 1,
+	RNG_STREAM_PICKUPS = 2,
+	RNG_STREAM_HAZARDS = 3,
+	RNG_STREAM_UPGRADES = 4,
+	MAX_RNG_STREAMS = 5,
+
+	// Damage Sources (Hits taken are counted per run, for balancing)
+	DAMAGE_SOURCE_FLYING = 0,
+	DAMAGE_SOURCE_WALKING = 1,
+	DAMAGE_SOURCE_LAZER = 2,
+	MAX_DAMAGE_SOURCES = 3,
+
+	// Player Animations (Picked by the simulation, drawn by game.c)
+	PLAYER_ANIMATION_IDLE = 0,
+	PLAYER_ANIMATION_RIGHT = 1,
+	PLAYER_ANIMATION_LEFT = 2,
+	PLAYER_ANIMATION_JUMP = 3,
+	PLAYER_ANIMATION_JUMP_RIGHT = 4,
+	PLAYER_ANIMATION_JUMP_LEFT = 5,
+	PLAYER_ANIMATION_FALL = 6,
+	PLAYER_ANIMATION_FALL_RIGHT = 7,
+	PLAYER_ANIMATION_FALL_LEFT = 8,
+
 };
 
-struct Platform {
-	float p1Coord, p2Coord;
-	int y, start, p1Length, p2Length, g1Length, g2Length;
+// Lines up a struct with the start of a cache line (CACHE_LINE_SIZE)
+#ifdef _MSC_VER
+#define CACHE_ALIGNED __declspec(align(64))
+#else
+#define CACHE_ALIGNED __attribute__((aligned(64)))
+#endif
+
+// One row of platforms, with every edge worked out by GeneratePlatform so collisions only compare floats.
+// Segment i is solid from left[i] up to (but not including) right[i]. Segments are sorted left to right
+// and do not overlap, so they can be searched with a binary search (see platforms.h)
+struct CACHE_ALIGNED Platform {
+	float left[MAX_PLATFORM_SEGMENTS]; // One SSE register each
+	float right[MAX_PLATFORM_SEGMENTS];
+	float top, bottom; // y * 100 -/+ platformHeight / 2
+	int y;
+	int segmentCount;
+
+	// Rolls for the walking enemies that spawn on this row, all 0 to 99 (see DifficultyPlatformModifier)
+	unsigned char spawnChance; // Enemies spawn if this is under the spawn chance
+	unsigned char spawnCount; // Picks how many spawn
+	unsigned char spawnX[PLATFORM_SPAWN_SLOTS]; // Where each one starts along its platform in percent, odd ones face right
+	unsigned char spawnSegment[PLATFORM_SPAWN_SLOTS]; // Platform each one spawns on (Already an index into left and right)
+};
+
+// Rows built before they are needed, so the step that reaches a new row only has to copy it.
+// Built by BuildQueuedPlatform (one per step) and taken by ShiftPlatform, oldest first.
+struct Platform_Queue {
+	struct Platform rows[PLATFORM_QUEUE_ROWS]; // Ring buffer
+	int head; // Index of the oldest row
+	int count; // Rows built
+	int nextY; // Y value of the next row to build
 };
 
 struct Player {
@@ -124,7 +206,7 @@ struct Player {
 	int maxHealth, currentHealth; // Health Variables (UI)
 	int movementSpeed, jumpSpeed; // Movement Variables
 
-	CP_Image *imageAddress;
+	int animation; // PLAYER_ANIMATION_*
 
 	int damage; // Bullet Damage
 	int isShooting; // Boolean
@@ -137,11 +219,11 @@ struct Player {
 	int projectileSpeed; // Speed of Bullets 
 
 	int killCount;
+};
 
-	// Sound Effects
-	CP_Sound jumpSFX;
-	CP_Sound damagedSFX;
-	CP_Sound pickupSFX;
+// Slots in use of an entity array, spawned and gone through with pool.h
+struct Entity_Pool {
+	unsigned long long live; // Bit i is set while slot i is in use
 };
 
 struct Bullet {
@@ -150,25 +232,32 @@ struct Bullet {
 	float diameterSize; // Diameter of the bullet
 	float distanceTraveled; // The distance the bullet has traveled (for limiting range)
 	float directionX, directionY; // Direction vector of the bullet
-	int isActive; // Indicates if the bullet is active
 };
 
 struct Flying_Enemy {
 	float x, y, diameter;
-	int enemyHealth, isActive, enemySpeed;
-	CP_Image *imageAddress;
+	int enemyHealth, enemySpeed;
 };
 
-struct Walking_Enemy {
-	float x, y, boundR, boundL;
-	int width, height, health, detectRange, speed, isActive, dir;
-	CP_Image* imageAddress;
+// One array per value (structure of arrays), walking enemy i is slot i of each.
+// WalkingEnemyLogic moves several at a time with SIMD, which needs the same value of neighbouring enemies next to each other.
+struct CACHE_ALIGNED Walking_Enemies {
+	float x[WALKING_ENEMY_CAPACITY];
+	float y[WALKING_ENEMY_CAPACITY];
+	float boundL[WALKING_ENEMY_CAPACITY]; // Edges of the platform it walks on
+	float boundR[WALKING_ENEMY_CAPACITY];
+	float speed[WALKING_ENEMY_CAPACITY];
+	float detectRange[WALKING_ENEMY_CAPACITY]; // Chases the player inside this distance
+	float dir[WALKING_ENEMY_CAPACITY]; // 0 is left, 1 is right
+	float width[WALKING_ENEMY_CAPACITY]; // Whole numbers, floats so the hit tests read them as they are
+	float height[WALKING_ENEMY_CAPACITY];
+	int health[WALKING_ENEMY_CAPACITY];
+	struct Entity_Pool pools[WALKING_ENEMY_POOLS]; // Slots in use, see the Pools functions in pool.h
 };
 
 struct Lazer_Hazard {
 	float y, height;
 	float timeToFire, timeCreated;
-	int isActive;
 };
 
 struct Upgrades {
@@ -179,8 +268,6 @@ struct Upgrades {
 struct Pickups {
 	float x, y;
 	float imageSize;
-	int isActive;
-	CP_Image *imageAddress;
 };
 
 struct Game_State_Upgrade {
@@ -196,6 +283,87 @@ struct Game_State_Defeat {
 	float secondsSinceState;
 };
 
+struct Difficulty {
+	// Walking Enemies (Rolled for every new platform, increments are per 2 upgrades)
+	int minSpawnPercentage, maxSpawnPercentage, spawnPercentageIncrement; // Chance of a platform getting walking enemies
+	int minWalkingEnemies, maxWalkingEnemies; // Per Platform
+	int minWalkingEnemiesHealth, walkingEnemiesHealthIncrement;
+	int minWalkingEnemiesSpeed, walkingEnemiesSpeedIncrement;
+
+	// Flying Enemies (From 2 upgrades on, increments are per 2 upgrades after that)
+	int flyingEnemiesSpawnTime; // Seconds between Flying Enemies
+	int minFlyingEnemiesHealth, flyingEnemiesHealthIncrement;
+	int minFlyingEnemiesSpeed, flyingEnemiesSpeedIncrement;
+
+	// Lazer Hazards (From 4 upgrades on)
+	int minHazardTimeToFire, maxHazardTimeToFire; // Seconds of warning, goes down from min to max
+	int minHazardHeight, maxHazardHeight, hazardHeightIncrement;
+	int minHazardSpawnTime, maxHazardSpawnTime; // Seconds between Lazers
+};
+
+struct Rng {
+	unsigned long long state[4]; // xoshiro256** State
+};
+
+struct Sim_Input {
+	// Input Flags
+	int wKeyPressed;
+	int wKeyTriggered;
+	int aKeyPressed;
+	int sKeyPressed;
+	int dKeyPressed;
+	int escKeyPressed;
+	int leftMouseClick;
+	int leftMouseHold;
+	int resumeClicked; // Resume Button of the Pause Menu
+	float mouseX, mouseY; // Mouse World Position
+};
+
+struct GameWorld {
+	int gameState;
+	struct Game_State_Upgrade gameStateUpgrade;
+	struct Game_State_Defeat gameStateDefeat;
+
+	struct Player player;
+	struct Platform platforms[MAX_PLATFORMS]; // Ring buffer, use GetPlatformRow (platforms.h) to go through the rows top to bottom
+	int platformHead; // Index of the top row in platforms
+	int platformCount; // Rows in platforms, PLATFORM_WINDOW_ROWS plus the lookahead
+	struct Platform_Queue platformQueue; // Rows after the bottom one, built ahead
+	struct Bullet bullets[MAX_BULLETS];
+	struct Flying_Enemy flyingEnemies[MAX_FLYING_ENEMIES];
+	struct Walking_Enemies walkingEnemies;
+	int walkingEnemyCap; // Walking enemy slots used, MAX_WALKING_ENEMIES unless raised with SetWalkingEnemyCap (enemy.h)
+	struct Pickups pickups[MAX_HEALTH_PICKUPS];
+	struct Lazer_Hazard lazerHazards[MAX_LAZER_HAZARDS];
+	// Slots in use of the arrays above (walking enemies keep their own)
+	struct Entity_Pool bulletPool;
+	struct Entity_Pool flyingEnemyPool;
+	struct Entity_Pool pickupPool;
+	struct Entity_Pool lazerHazardPool;
+
+	float maxY; // Maximum Y the player has reached. (Camera follows this value)
+	float wallWidth;
+	float platformHeight;
+	float scoreMultipler;
+	float gameTimer;
+	float lastShotTimer;
+	float lastSpawnTimer;
+	float lazerSpawnedTimer;
+	int nextLazerTimer;
+	int isTouching;
+	int doubleJumpUsed;
+	int fallingThroughPlatform;
+	int lastPlayerHeightThreshold;
+	int distanceBetweenPlatform;
+
+	int soundEvents; // SIM_SOUND_* raised during the last Sim_Step, played by game.c
+	int damageTaken[MAX_DAMAGE_SOURCES]; // Hits taken from each DAMAGE_SOURCE_* this run
+	struct Difficulty difficulty; // Tuning values, can be changed after Sim_Init
+
+	unsigned long long seed; // Seed the run was started with
+	struct Rng rng[MAX_RNG_STREAMS];
+};
+
 /// <summary>
 /// Initializes the Player
 /// </summary>
@@ -219,28 +387,38 @@ void InitializeGameStateDefeat(struct Game_State_Defeat* p);
 /// Initializes the Bullet Struct Array
 /// </summary>
 /// <param name="bullets">Array of Bullets</param>
-void InitializeBullets(struct Bullet bullets[]);
+/// <param name="pool">Address of the Pool of the Bullets</param>
+void InitializeBullets(struct Bullet bullets[], struct Entity_Pool* pool);
 
 /// <summary>
 /// Initializes Flying Enemies
 /// </summary>
 /// <param name="enemies">Array of Flying Enemies</param>
-void InitializeFlyingEnemies(struct Flying_Enemy enemies[]);
+/// <param name="pool">Address of the Pool of the Flying Enemies</param>
+void InitializeFlyingEnemies(struct Flying_Enemy enemies[], struct Entity_Pool* pool);
 
 /// <summary>
-/// Initializes the Walking_Enemy Struct Array
+/// Initializes the Walking_Enemies Struct
 /// </summary>
-/// <param name="enem">Array of Walking Enemies</param>
-void InitializeWalkingEnemies(struct Walking_Enemy enem[]);
+/// <param name="enem">Address of the Walking Enemies</param>
+void InitializeWalkingEnemies(struct Walking_Enemies* enem);
 
 /// <summary>
 /// Intitializes Pickups
 /// </summary>
 /// <param name="pickup">Array of Pickups</param>
-void InitializePickups(struct Pickups pickup[]);
+/// <param name="pool">Address of the Pool of the Pickups</param>
+void InitializePickups(struct Pickups pickup[], struct Entity_Pool* pool);
+
+/// <summary>
+/// Sets the Difficulty to the DIFFICULTY_* values
+/// </summary>
+/// <param name="d">Address of the Difficulty</param>
+void InitializeDifficulty(struct Difficulty* d);
 
 /// <summary>
 /// Initializes Lazer Hazards
 /// </summary>
 /// <param name="lazerHazards">Array of Lazer Hazards</param>
-void InitializeLazerHazard(struct Lazer_Hazard lazerHazards[]);
+/// <param name="pool">Address of the Pool of the Lazer Hazards</param>
+void InitializeLazerHazard(struct Lazer_Hazard lazerHazards[], struct Entity_Pool* pool);
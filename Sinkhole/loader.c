@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------------------
+// file: loader.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Asset Loader, loading the assets of the manifest while the splash screen plays
+//		Changed images in the image pack to be read from the pack instead of their PNG
+//		Added Loader_Shutdown, stopping the loader thread when the game closes early
+//
+// brief:
+// Contains the loader thread and the functions the main thread uses to make
+// the assets it has read. The completion queue has one writer (the loader
+// thread, which moves the tail) and one reader (the main thread, which moves
+// the head), so each side only needs to see the other's index with
+// acquire/release ordering, no lock.
+// The loader thread reads every byte of each file, so the fonts, PNGs and
+// sounds are in memory (the file cache of the OS) when the main thread loads
+// them, and the main thread never waits on the disk. Images in the image pack
+// are read by touching each page of their pixels, the pack holds them in the
+// order of the manifest, so that reads the pack from start to end.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "cprocessing.h"
+#include "initialize.h"
+#include "assets.h"
+#include "loader.h"
+
+struct Loader_Entry {
+	enum Asset_Type type;
+	char path[MAX_ASSET_FILEPATH];
+};
+
+struct Loader_Entry loaderEntries[MAX_ASSETS];
+int loaderEntryCount;
+int loaderMade; // Entries made into assets by the main thread
+int isLoaderRunning; // Started and not joined yet
+int isLoaderStarted;
+
+int loaderQueue[LOADER_QUEUE_SIZE]; // Entries read by the loader thread, waiting for the main thread
+volatile long loaderQueueHead; // Next entry to take off, only moved by the main thread
+volatile long loaderQueueTail; // Next place to put an entry, only moved by the loader thread
+volatile long loaderCancelled; // Set by the main thread, the loader thread stops before its next entry
+char loaderReadBuffer[LOADER_READ_SIZE]; // Only used by the loader thread
+volatile unsigned char loaderTouched; // Sum of the pack bytes touched, so the reads are not optimized away
+
+#pragma region threads
+
+#ifdef _WIN32
+typedef HANDLE Loader_Thread;
+
+long LoaderLoadAcquire(volatile long* value) {
+	return InterlockedCompareExchange(value, 0, 0);
+}
+
+void LoaderStoreRelease(volatile long* value, long newValue) {
+	InterlockedExchange(value, newValue);
+}
+#else
+typedef pthread_t Loader_Thread;
+
+long LoaderLoadAcquire(volatile long* value) {
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+void LoaderStoreRelease(volatile long* value, long newValue) {
+	__atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+}
+#endif
+
+Loader_Thread loaderThread;
+
+void LoaderReadAll(void) {
+	for (int i = 0; i < loaderEntryCount && !LoaderLoadAcquire(&loaderCancelled); ++i) {
+		FILE* file;
+		size_t size;
+		const unsigned char* pixels = loaderEntries[i].type == ASSET_IMAGE ? Assets_GetPackedPixels(loaderEntries[i].path, &size) : NULL;
+		if (pixels != NULL) {
+			unsigned char sum = 0;
+			for (size_t offset = 0; offset < size; offset += LOADER_PAGE_SIZE) {
+				sum += pixels[offset]; // Maps the page in, it is only copied if written to
+			}
+			loaderTouched += sum;
+		} else if (fopen_s(&file, loaderEntries[i].path, "rb") == 0) {
+			while (fread(loaderReadBuffer, 1, LOADER_READ_SIZE, file) == LOADER_READ_SIZE) {
+				// Only reading, the main thread loads it from the file cache
+			}
+			fclose(file);
+		}
+		// Files that can not be read are still put on the queue, the main thread loads them like before
+		long tail = loaderQueueTail;
+		loaderQueue[tail & (LOADER_QUEUE_SIZE - 1)] = i; // Never full, every entry fits
+		LoaderStoreRelease(&loaderQueueTail, tail + 1);
+	}
+}
+
+#ifdef _WIN32
+DWORD WINAPI LoaderThreadMain(LPVOID unused) {
+	(void)unused;
+	LoaderReadAll();
+	return 0;
+}
+
+int LoaderStartThread(void) {
+	loaderThread = CreateThread(NULL, 0, LoaderThreadMain, NULL, 0, NULL);
+	return loaderThread != NULL;
+}
+
+void LoaderJoinThread(void) {
+	WaitForSingleObject(loaderThread, INFINITE);
+	CloseHandle(loaderThread);
+}
+#else
+void* LoaderThreadMain(void* unused) {
+	(void)unused;
+	LoaderReadAll();
+	return NULL;
+}
+
+int LoaderStartThread(void) {
+	return pthread_create(&loaderThread, NULL, LoaderThreadMain, NULL) == 0;
+}
+
+void LoaderJoinThread(void) {
+	pthread_join(loaderThread, NULL);
+}
+#endif
+
+#pragma endregion
+
+#pragma region manifest
+
+// Reads the "type,path" lines of the manifest. Lines of an unknown type are left out
+int LoaderReadManifest(const char* manifestPath) {
+	FILE* file;
+	if (fopen_s(&file, manifestPath, "r") != 0) {
+		return 0;
+	}
+	char line[MAX_ASSET_FILEPATH + 16];
+	loaderEntryCount = 0;
+	while (loaderEntryCount < MAX_ASSETS && fgets(line, sizeof(line), file) != NULL) {
+		line[strcspn(line, "\r\n")] = '\0';
+		char* path = strchr(line, ',');
+		if (path == NULL || strlen(path + 1) >= MAX_ASSET_FILEPATH) {
+			continue;
+		}
+		*path++ = '\0';
+		enum Asset_Type type = ASSET_NONE;
+		if (strcmp(line, "font") == 0) {
+			type = ASSET_FONT;
+		} else if (strcmp(line, "image") == 0) {
+			type = ASSET_IMAGE;
+		} else if (strcmp(line, "sound") == 0) {
+			type = ASSET_SOUND;
+		} else if (strcmp(line, "music") == 0) {
+			type = ASSET_MUSIC;
+		}
+		if (type != ASSET_NONE) {
+			loaderEntries[loaderEntryCount].type = type;
+			strcpy_s(loaderEntries[loaderEntryCount].path, MAX_ASSET_FILEPATH, path);
+			loaderEntryCount++;
+		}
+	}
+	fclose(file);
+	return 1;
+}
+
+#pragma endregion
+
+// Loads an entry into the Asset Registry, keeping the reference
+void LoaderMake(const struct Loader_Entry* entry) {
+	if (entry->type == ASSET_FONT) {
+		Assets_LoadFont(entry->path);
+	} else if (entry->type == ASSET_IMAGE) {
+		Assets_LoadImage(entry->path);
+	} else if (entry->type == ASSET_SOUND) {
+		Assets_LoadSound(entry->path);
+	} else {
+		Assets_LoadMusic(entry->path);
+	}
+	loaderMade++;
+}
+
+// Makes the entries on the queue, until the queue is empty or the time (in clock ticks) runs out. -1 for no limit
+void LoaderMakeQueued(clock_t budget) {
+	clock_t start = clock();
+	long head = loaderQueueHead;
+	long tail = LoaderLoadAcquire(&loaderQueueTail);
+	while (head != tail && (budget < 0 || clock() - start < budget)) {
+		LoaderMake(&loaderEntries[loaderQueue[head & (LOADER_QUEUE_SIZE - 1)]]);
+		head++;
+		LoaderStoreRelease(&loaderQueueHead, head);
+	}
+}
+
+int Loader_Start(const char* manifestPath) {
+	if (isLoaderStarted) {
+		return 0;
+	}
+	if (!LoaderReadManifest(manifestPath) || !LoaderStartThread()) {
+		return 0;
+	}
+	isLoaderStarted = 1;
+	isLoaderRunning = 1;
+	return 1;
+}
+
+void Loader_Update(void) {
+	if (!isLoaderRunning) {
+		return;
+	}
+	LoaderMakeQueued(LOADER_FRAME_BUDGET * CLOCKS_PER_SEC / 1000);
+	if (loaderMade == loaderEntryCount) {
+		LoaderJoinThread(); // Already done, every entry was put on the queue
+		isLoaderRunning = 0;
+	}
+}
+
+void Loader_Finish(void) {
+	if (!isLoaderRunning) {
+		return;
+	}
+	LoaderJoinThread();
+	isLoaderRunning = 0;
+	LoaderMakeQueued(-1);
+}
+
+void Loader_Shutdown(void) {
+	if (!isLoaderRunning) {
+		return;
+	}
+	LoaderStoreRelease(&loaderCancelled, 1);
+	LoaderJoinThread();
+	isLoaderRunning = 0;
+}
+
+float Loader_GetProgress(void) {
+	if (!isLoaderStarted || loaderEntryCount == 0) {
+		return 1.0f;
+	}
+	return (float)loaderMade / loaderEntryCount;
+}
@@ -0,0 +1,71 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: loader.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Asset Loader, loading the assets of the manifest while the splash screen plays
+//
+// brief:
+// Contains the declaration of functions in loader.c.
+// Loads every asset listed in the manifest (Assets/Data/assets.csv, one
+// "type,path" per line) into the Asset Registry before the game needs them.
+// A loader thread reads each file from the disk and puts it on a lock-free
+// completion queue. Each frame, the main thread takes what is ready off the
+// queue and turns it into a font, image or sound, for up to LOADER_FRAME_BUDGET
+// milliseconds. Textures, fonts and sounds belong to the window and sound
+// system, so only the main thread makes them.
+// The loader keeps a reference to every asset, so Assets_Evict leaves them loaded.
+// Images in the image pack have nothing to decode, the loader thread only
+// brings their pages into memory.
+//
+// Loading while a screen plays:
+//	Loader_Start(LOADER_MANIFEST); // In Init
+//	Loader_Update(); // Every frame, Loader_GetProgress() for how far it is
+//	Loader_Finish(); // Before the assets have to be there
+//	Loader_Shutdown(); // When the game closes, in case it closed before Loader_Finish
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#define LOADER_MANIFEST "Assets/Data/assets.csv"
+
+enum {
+	LOADER_FRAME_BUDGET = 4, // Milliseconds of each frame spent making assets
+	LOADER_QUEUE_SIZE = MAX_ASSETS, // Power of two, every asset of the manifest fits
+	LOADER_READ_SIZE = 64 * 1024, // Bytes read from a file at a time
+	LOADER_PAGE_SIZE = 4096, // Bytes apart the pixels of a packed image are touched, a memory page
+};
+
+/// <summary>
+/// Reads the manifest and starts the loader thread. Nothing happens if it was already started.
+/// </summary>
+/// <param name="manifestPath">Manifest File</param>
+/// <returns>1 if started, 0 if the manifest could not be read or the thread could not start</returns>
+int Loader_Start(const char* manifestPath);
+
+/// <summary>
+/// Makes the assets that are ready, for up to LOADER_FRAME_BUDGET milliseconds. Run this every frame.
+/// </summary>
+void Loader_Update(void);
+
+/// <summary>
+/// Waits for the loader thread and makes every asset left. Nothing happens if the loader was not started.
+/// </summary>
+void Loader_Finish(void);
+
+/// <summary>
+/// Stops the loader thread without making what is left, for when the game closes before the
+/// loader is done. Run this before closing the image pack, the thread reads from it.
+/// Nothing happens if the loader is not running.
+/// </summary>
+void Loader_Shutdown(void);
+
+/// <summary>
+/// Gets how much of the manifest is loaded.
+/// </summary>
+/// <returns>0 to 1, 1 if the loader was not started</returns>
+float Loader_GetProgress(void);
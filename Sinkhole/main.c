@@ -3,6 +3,9 @@
 //
 // authors:
 // Prof DX & Prof Gerald
+// l.zheneudamon
+//		Added opening the image pack before the first scene
+//		Added stopping the asset loader before the image pack is closed
 //
 // brief:
 // Main entry point for the SinkHole game.
@@ -14,14 +17,29 @@
 //------------------------------------------------------------------------------------
 
 #include "cprocessing.h"
+#include <string.h>
 #include "splashscreen.h"
+#include "game.h"
+#include "pack.h"
+#include "assets.h"
+#include "loader.h"
 
 // main() the starting point for the program
 // CP_Engine_SetNextGameState() tells CProcessing which functions to use for init, update and exit
 // CP_Engine_Run() is the core function that starts the simulation
-int main(void) {
-	CP_Engine_SetNextGameState(Splash_Screen_Init, Splash_Screen_Update, Splash_Screen_Exit);
+// Assets_OpenPack() makes images from the image pack when it was built, else they are loaded from their PNG
+// "Sinkhole.exe -replay last_run.replay" skips the menus and plays back a recorded run
+int main(int argc, char* argv[]) {
+	if (argc > 2 && strcmp(argv[1], "-replay") == 0) {
+		Game_SetReplayFile(argv[2]);
+		CP_Engine_SetNextGameState(Game_Init, Game_Update, Game_Exit);
+	} else {
+		CP_Engine_SetNextGameState(Splash_Screen_Init, Splash_Screen_Update, Splash_Screen_Exit);
+	}
+	Assets_OpenPack(PACK_FILE);
 	CP_System_SetWindowSize(1600, 900);
 	CP_Engine_Run();
+	Loader_Shutdown(); // The window can close during the splash screen, while the loader thread still reads the pack
+	Assets_ClosePack();
 	return 0;
 }
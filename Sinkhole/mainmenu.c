@@ -6,6 +6,10 @@
 //		Added Content of Main Menu (Buttons & Text)
 //		Added Drawing of Looping Background
 //		Added Music
+// l.zheneudamon
+//		Changed fonts to be loaded once in Init, through the Asset Registry
+//		Changed images and music to be kept across scenes by the Asset Registry
+//		Added loading of the assets left, if the splash screen was skipped
 //
 // brief:
 // Contains the main logic of the Main Menu.
@@ -19,8 +23,9 @@
 
 #include <stdio.h>
 #include <stdlib.h> 
-#include <time.h> 
 #include "cprocessing.h"
+#include "assets.h"
+#include "loader.h"
 #include "game.h"
 #include "credits.h"
 #include "utils.h"
@@ -49,9 +54,11 @@ float backgroundHeight1;
 float backgroundHeight2;
 
 void Main_Menu_Init(void) {
-	backgroundImage = CP_Image_Load("Assets/Images/Background/background.png");
+	backgroundImage = Assets_LoadImage("Assets/Images/Background/background.png");
 
-	menuTrack = CP_Sound_LoadMusic("Assets/Music/lost_civilization.mp3");
+	menuTrack = Assets_LoadMusic("Assets/Music/lost_civilization.mp3");
+	titleFont = Assets_GetFont(Assets_LoadFont("Assets/Fonts/Frijole-Regular.ttf"));
+	buttonFont = Assets_GetFont(Assets_LoadFont("Assets/Fonts/Margarine-Regular.ttf"));
 
 	leftMouseClick = 0;
 	playMusicOnce = 0;
@@ -76,8 +83,6 @@ void Main_Menu_Init(void) {
 
 	// Starting height of background 2.
 	backgroundHeight2 = 0.0f;
-
-	srand((unsigned int)time(NULL));
 }
 
 void Main_Menu_Update(void) {
@@ -88,6 +93,7 @@ void Main_Menu_Update(void) {
 		CP_Sound_PlayMusic(menuTrack);
 	}
 
+	Loader_Update(); // Only loading if the splash screen was skipped before it was done
 	leftMouseClick = CP_Input_MouseTriggered(MOUSE_BUTTON_LEFT);
 
 	deltaTime = CP_System_GetDt();
@@ -109,7 +115,6 @@ void Main_Menu_Update(void) {
 
 	// Title Text
 	CP_Settings_TextSize(250.0f);
-	titleFont = CP_Font_Load("Assets/Fonts/Frijole-Regular.ttf");
 	CP_Font_Set(titleFont);
 	
 	CP_Settings_Fill(black);
@@ -118,7 +123,6 @@ void Main_Menu_Update(void) {
 	
 	// Button Text
 	CP_Settings_TextSize(150.0f);
-	buttonFont = CP_Font_Load("Assets/Fonts/Margarine-Regular.ttf");
 	CP_Font_Set(buttonFont);
 
 	CP_Settings_TextAlignment(CP_TEXT_ALIGN_H_CENTER, CP_TEXT_ALIGN_V_MIDDLE);
@@ -178,6 +182,6 @@ void Main_Menu_Update(void) {
 }
 
 void Main_Menu_Exit(void) {
-	CP_Image_Free(&backgroundImage);
-	CP_Sound_Free(&menuTrack);
+	Assets_ReleaseImage(&backgroundImage);
+	Assets_ReleaseSound(&menuTrack);
 }
@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------------
+// file: pack.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Image Pack, every image decoded ahead of time into one file
+//
+// brief:
+// Contains functions used to map an image pack and find its images.
+// The file is mapped copy on write, so the pixels can be handed to functions
+// that take them as writable without changing the file. Pages are only read
+// from the disk when they are first used, reading the pack in order (like the
+// loader thread does) reads it in one sweep.
+// Entries are checked before anything is read through them, so a pack that
+// is cut short or made up can not point outside the file.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "pack.h"
+
+#pragma region mapping
+
+#ifdef _WIN32
+int PackMap(struct Image_Pack* pack, const char* path) {
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return 0;
+	}
+	LARGE_INTEGER size;
+	HANDLE mapping = GetFileSizeEx(file, &size) && size.QuadPart > 0 ? CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL) : NULL;
+	void* data = mapping != NULL ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : NULL;
+	if (data == NULL) {
+		if (mapping != NULL) {
+			CloseHandle(mapping);
+		}
+		CloseHandle(file);
+		return 0;
+	}
+	pack->data = data;
+	pack->size = (size_t)size.QuadPart;
+	pack->file = file;
+	pack->mapping = mapping;
+	return 1;
+}
+
+void PackUnmap(struct Image_Pack* pack) {
+	UnmapViewOfFile(pack->data);
+	CloseHandle(pack->mapping);
+	CloseHandle(pack->file);
+}
+#else
+int PackMap(struct Image_Pack* pack, const char* path) {
+	int file = open(path, O_RDONLY);
+	if (file < 0) {
+		return 0;
+	}
+	struct stat info;
+	void* data = fstat(file, &info) == 0 && info.st_size > 0 ? mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0) : MAP_FAILED;
+	close(file); // The mapping keeps the file open
+	if (data == MAP_FAILED) {
+		return 0;
+	}
+	pack->data = data;
+	pack->size = (size_t)info.st_size;
+	pack->file = NULL;
+	pack->mapping = NULL;
+	return 1;
+}
+
+void PackUnmap(struct Image_Pack* pack) {
+	munmap(pack->data, pack->size);
+}
+#endif
+
+#pragma endregion
+
+int Pack_Open(struct Image_Pack* pack, const char* path) {
+	memset(pack, 0, sizeof(*pack));
+	if (!PackMap(pack, path)) {
+		return 0;
+	}
+	const struct Pack_Header* header = (const struct Pack_Header*)pack->data;
+	int isValid = pack->size >= sizeof(struct Pack_Header)
+		&& memcmp(header->magic, PACK_MAGIC, sizeof(header->magic)) == 0
+		&& header->version == PACK_VERSION
+		&& header->count <= (pack->size - sizeof(struct Pack_Header)) / sizeof(struct Pack_Entry);
+	const struct Pack_Entry* entries = (const struct Pack_Entry*)(pack->data + sizeof(struct Pack_Header));
+	for (unsigned int i = 0; isValid && i < header->count; ++i) { // Every image has to be inside the file
+		const struct Pack_Entry* entry = &entries[i];
+		isValid = memchr(entry->path, '\0', PACK_PATH_SIZE) != NULL
+			&& entry->width >= 1 && entry->width <= PACK_MAX_SIZE // So the size below can not wrap around
+			&& entry->height >= 1 && entry->height <= PACK_MAX_SIZE
+			&& entry->offset <= pack->size
+			&& (unsigned long long)entry->width * entry->height * 4 <= pack->size - entry->offset;
+	}
+	if (!isValid) {
+		PackUnmap(pack);
+		memset(pack, 0, sizeof(*pack));
+		return 0;
+	}
+	pack->entries = entries;
+	pack->count = (int)header->count;
+	return 1;
+}
+
+const struct Pack_Entry* Pack_Find(const struct Image_Pack* pack, const char* path) {
+	int low = 0, high = pack->count - 1;
+	while (low <= high) { // Entries are sorted by path
+		int middle = (low + high) / 2;
+		int order = strcmp(path, pack->entries[middle].path);
+		if (order == 0) {
+			return &pack->entries[middle];
+		}
+		if (order < 0) {
+			high = middle - 1;
+		} else {
+			low = middle + 1;
+		}
+	}
+	return NULL;
+}
+
+unsigned char* Pack_GetPixels(const struct Image_Pack* pack, const struct Pack_Entry* entry) {
+	return pack->data + entry->offset;
+}
+
+int Pack_GetStamp(const char* path, unsigned long long* size, unsigned long long* time) {
+#ifdef _WIN32
+	struct _stat64 info;
+	if (_stat64(path, &info) != 0) {
+		return 0;
+	}
+#else
+	struct stat info;
+	if (stat(path, &info) != 0) {
+		return 0;
+	}
+#endif
+	*size = (unsigned long long)info.st_size;
+	*time = (unsigned long long)info.st_mtime;
+	return 1;
+}
+
+int Pack_IsCurrent(const struct Pack_Entry* entry) {
+	unsigned long long size, time;
+	if (!Pack_GetStamp(entry->path, &size, &time)) { // Shipped without the PNG, the pack is all there is
+		return 1;
+	}
+	return size == entry->sourceSize && time == entry->sourceTime;
+}
+
+void Pack_Close(struct Image_Pack* pack) {
+	if (pack->data != NULL) {
+		PackUnmap(pack);
+	}
+	memset(pack, 0, sizeof(*pack));
+}
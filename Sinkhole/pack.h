@@ -0,0 +1,109 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: pack.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Image Pack, every image decoded ahead of time into one file
+//
+// brief:
+// Contains the declaration of functions in pack.c.
+// An image pack holds the pixels of many images, already decoded to RGBA, so
+// making a texture from one is a copy instead of opening and inflating a PNG.
+// packer.c builds it from the images of the manifest. The game maps the whole
+// file into memory and finds images by their path.
+// Each entry keeps the size and last write time its PNG had when it was
+// packed, an image whose PNG changed since is loaded from the PNG instead.
+//
+// Layout (little endian, like every platform the game runs on):
+//	struct Pack_Header
+//	struct Pack_Entry[count], sorted by path
+//	Pixels of each image, width * height * 4 bytes (RGBA, rows top to bottom),
+//	each starting on a multiple of PACK_ALIGNMENT, in the order of the manifest
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#include <stddef.h>
+
+#define PACK_FILE "Assets/Data/images.pack"
+#define PACK_MAGIC "SKPK"
+
+enum {
+	PACK_VERSION = 2, // Changed whenever the layout changes, older packs are not opened
+	PACK_MAX_SIZE = 16384, // Most pixels on a side of an image
+	PACK_PATH_SIZE = 128, // Characters in the path of an entry, including the '\0'
+	PACK_ALIGNMENT = 64, // Bytes, pixels of each image start on a cache line
+};
+
+struct Pack_Header {
+	char magic[4]; // PACK_MAGIC, without the '\0'
+	unsigned int version;
+	unsigned int count; // Entries
+	unsigned int reserved;
+};
+
+struct Pack_Entry {
+	char path[PACK_PATH_SIZE]; // Path of the PNG it was made from, like "Assets/Images/UI/full_heart.png"
+	unsigned int width, height; // 1 to PACK_MAX_SIZE
+	unsigned long long offset; // Bytes from the start of the file to the pixels
+	unsigned long long sourceSize, sourceTime; // Of the PNG when it was packed, see Pack_GetStamp
+};
+
+struct Image_Pack {
+	unsigned char* data; // The whole file, mapped copy on write
+	size_t size;
+	const struct Pack_Entry* entries;
+	int count;
+	void* file; // Windows file and mapping handles
+	void* mapping;
+};
+
+/// <summary>
+/// Maps a pack into memory and checks its header and entries.
+/// </summary>
+/// <param name="pack">Address of the Pack to open</param>
+/// <param name="path">Pack File</param>
+/// <returns>1 if opened, 0 if it is missing, from another version or cut short</returns>
+int Pack_Open(struct Image_Pack* pack, const char* path);
+
+/// <summary>
+/// Finds an image by its path.
+/// </summary>
+/// <param name="pack">Address of the Pack</param>
+/// <param name="path">Path of the PNG the image was made from</param>
+/// <returns>Address of the Entry, NULL if the image is not in the pack</returns>
+const struct Pack_Entry* Pack_Find(const struct Image_Pack* pack, const char* path);
+
+/// <summary>
+/// Gets the pixels of an image.
+/// </summary>
+/// <param name="pack">Address of the Pack</param>
+/// <param name="entry">Address of the Entry, from Pack_Find</param>
+/// <returns>width * height RGBA pixels</returns>
+unsigned char* Pack_GetPixels(const struct Image_Pack* pack, const struct Pack_Entry* entry);
+
+/// <summary>
+/// Gets the size and last write time of a file, what an entry keeps of its PNG.
+/// </summary>
+/// <param name="path">File path</param>
+/// <param name="size">Address of the size to fill in, in bytes</param>
+/// <param name="time">Address of the time to fill in</param>
+/// <returns>1 if the file is there, else 0</returns>
+int Pack_GetStamp(const char* path, unsigned long long* size, unsigned long long* time);
+
+/// <summary>
+/// Checks that the PNG of an image has not changed since it was packed.
+/// </summary>
+/// <param name="entry">Address of the Entry</param>
+/// <returns>1 if the PNG is the same (or is not there), 0 if it has to be loaded instead</returns>
+int Pack_IsCurrent(const struct Pack_Entry* entry);
+
+/// <summary>
+/// Unmaps a pack. Nothing happens if it was not opened.
+/// </summary>
+/// <param name="pack">Address of the Pack</param>
+void Pack_Close(struct Image_Pack* pack);
@@ -0,0 +1,563 @@
+//------------------------------------------------------------------------------------
+// file: packer.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Image Packer, decoding every image of the manifest into one pack
+//		Added the size and write time of each PNG to its entry, run by the Visual Studio build
+//
+// brief:
+// Builds the image pack (see pack.h) from the images listed in the manifest.
+// Each PNG is inflated and unfiltered here, once, so the game only copies
+// pixels. Handles the PNGs the game has: 8 bits per channel, not interlaced,
+// any color type. Images it can not decode are left out with a message, the
+// game loads those from the PNG like before.
+// Not part of the game: the Visual Studio build compiles it (with pack.c) and
+// runs it from the folder with Assets in it whenever the manifest, an image
+// or the packer changed, see README.md for the command line elsewhere.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#define _CRT_SECURE_NO_WARNINGS // Command line tool, plain fopen is fine
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pack.h"
+
+#define PACKER_MANIFEST "Assets/Data/assets.csv" // LOADER_MANIFEST
+
+enum {
+	PACKER_MAX_IMAGES = 256,
+	PACKER_MAX_BITS = 15, // Longest Huffman code of deflate
+	PACKER_LITERAL_CODES = 288,
+	PACKER_DISTANCE_CODES = 30,
+};
+
+struct Packer_Image {
+	char path[PACK_PATH_SIZE];
+	unsigned int width, height;
+	unsigned long long sourceSize, sourceTime; // From Pack_GetStamp
+	unsigned char* pixels; // RGBA
+};
+
+#pragma region inflate
+
+// Deflate stream (RFC 1951) being read, and the bytes written out of it
+struct Packer_Stream {
+	const unsigned char* data;
+	size_t size, position;
+	unsigned int bitBuffer;
+	int bitCount;
+	unsigned char* out;
+	size_t outSize, outPosition;
+	int isBroken; // Set when the stream reads past its end or is not valid
+};
+
+// Canonical Huffman code, as counts of codes of each length and the symbols in code order
+struct Packer_Huffman {
+	short counts[PACKER_MAX_BITS + 1];
+	short symbols[PACKER_LITERAL_CODES];
+};
+
+static const short lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const short lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const short distanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const short distanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+int PackerBits(struct Packer_Stream* stream, int count) {
+	unsigned int value = stream->bitBuffer;
+	while (stream->bitCount < count) {
+		if (stream->position >= stream->size) {
+			stream->isBroken = 1;
+			return 0;
+		}
+		value |= (unsigned int)stream->data[stream->position++] << stream->bitCount;
+		stream->bitCount += 8;
+	}
+	stream->bitBuffer = value >> count;
+	stream->bitCount -= count;
+	return (int)(value & ((1u << count) - 1));
+}
+
+// Builds a code from the code length of each symbol. 0 if the lengths make no code
+int PackerBuildHuffman(struct Packer_Huffman* huffman, const short lengths[], int count) {
+	memset(huffman->counts, 0, sizeof(huffman->counts));
+	for (int i = 0; i < count; ++i) {
+		huffman->counts[lengths[i]]++;
+	}
+	int left = 1; // Codes of the current length not used yet
+	for (int length = 1; length <= PACKER_MAX_BITS; ++length) {
+		left = (left << 1) - huffman->counts[length];
+		if (left < 0) { // More codes than fit
+			return 0;
+		}
+	}
+	short offsets[PACKER_MAX_BITS + 1];
+	offsets[1] = 0;
+	for (int length = 1; length < PACKER_MAX_BITS; ++length) {
+		offsets[length + 1] = offsets[length] + huffman->counts[length];
+	}
+	for (int i = 0; i < count; ++i) {
+		if (lengths[i] != 0) {
+			huffman->symbols[offsets[lengths[i]]++] = (short)i;
+		}
+	}
+	return 1;
+}
+
+int PackerDecode(struct Packer_Stream* stream, const struct Packer_Huffman* huffman) {
+	int code = 0, first = 0, index = 0; // First code of the current length, and its place in symbols
+	for (int length = 1; length <= PACKER_MAX_BITS; ++length) {
+		code |= PackerBits(stream, 1);
+		int count = huffman->counts[length];
+		if (code - first < count) {
+			return huffman->symbols[index + code - first];
+		}
+		index += count;
+		first = (first + count) << 1;
+		code <<= 1;
+	}
+	stream->isBroken = 1;
+	return 0;
+}
+
+void PackerInflateCodes(struct Packer_Stream* stream, const struct Packer_Huffman* literals, const struct Packer_Huffman* distances) {
+	while (!stream->isBroken) {
+		int symbol = PackerDecode(stream, literals);
+		if (symbol < 256) { // Literal byte
+			if (stream->outPosition >= stream->outSize) {
+				stream->isBroken = 1;
+				return;
+			}
+			stream->out[stream->outPosition++] = (unsigned char)symbol;
+		} else if (symbol == 256) { // End of the block
+			return;
+		} else { // Copy of earlier bytes
+			symbol -= 257;
+			if (symbol >= 29) {
+				stream->isBroken = 1;
+				return;
+			}
+			size_t length = lengthBase[symbol] + PackerBits(stream, lengthExtra[symbol]);
+			int distanceSymbol = PackerDecode(stream, distances);
+			if (distanceSymbol >= PACKER_DISTANCE_CODES) {
+				stream->isBroken = 1;
+				return;
+			}
+			size_t distance = distanceBase[distanceSymbol] + PackerBits(stream, distanceExtra[distanceSymbol]);
+			if (distance > stream->outPosition || length > stream->outSize - stream->outPosition) {
+				stream->isBroken = 1;
+				return;
+			}
+			for (size_t i = 0; i < length; ++i, ++stream->outPosition) { // Byte at a time, the copy can overlap itself
+				stream->out[stream->outPosition] = stream->out[stream->outPosition - distance];
+			}
+		}
+	}
+}
+
+void PackerInflateStored(struct Packer_Stream* stream) {
+	stream->bitBuffer = 0; // Stored blocks start on a byte
+	stream->bitCount = 0;
+	if (stream->size - stream->position < 4) {
+		stream->isBroken = 1;
+		return;
+	}
+	const unsigned char* header = &stream->data[stream->position];
+	size_t length = header[0] | (header[1] << 8);
+	if ((size_t)(header[2] | (header[3] << 8)) != (~length & 0xffff)) {
+		stream->isBroken = 1;
+		return;
+	}
+	stream->position += 4;
+	if (stream->size - stream->position < length || stream->outSize - stream->outPosition < length) {
+		stream->isBroken = 1;
+		return;
+	}
+	memcpy(&stream->out[stream->outPosition], &stream->data[stream->position], length);
+	stream->position += length;
+	stream->outPosition += length;
+}
+
+void PackerInflateFixed(struct Packer_Stream* stream) {
+	static struct Packer_Huffman literals, distances;
+	static int isBuilt = 0;
+	if (!isBuilt) {
+		short lengths[PACKER_LITERAL_CODES];
+		for (int i = 0; i < PACKER_LITERAL_CODES; ++i) {
+			lengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+		}
+		PackerBuildHuffman(&literals, lengths, PACKER_LITERAL_CODES);
+		for (int i = 0; i < PACKER_DISTANCE_CODES; ++i) {
+			lengths[i] = 5;
+		}
+		PackerBuildHuffman(&distances, lengths, PACKER_DISTANCE_CODES);
+		isBuilt = 1;
+	}
+	PackerInflateCodes(stream, &literals, &distances);
+}
+
+void PackerInflateDynamic(struct Packer_Stream* stream) {
+	static const short order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+	int literalCount = PackerBits(stream, 5) + 257;
+	int distanceCount = PackerBits(stream, 5) + 1;
+	int codeLengthCount = PackerBits(stream, 4) + 4;
+	if (literalCount > PACKER_LITERAL_CODES || distanceCount > PACKER_DISTANCE_CODES) {
+		stream->isBroken = 1;
+		return;
+	}
+
+	// Code lengths of the code lengths
+	short lengths[PACKER_LITERAL_CODES + PACKER_DISTANCE_CODES] = { 0 };
+	for (int i = 0; i < codeLengthCount; ++i) {
+		lengths[order[i]] = (short)PackerBits(stream, 3);
+	}
+	struct Packer_Huffman lengthCode, literals, distances;
+	if (!PackerBuildHuffman(&lengthCode, lengths, 19)) {
+		stream->isBroken = 1;
+		return;
+	}
+
+	// Code lengths of the literals and distances, in one run
+	int total = literalCount + distanceCount;
+	for (int i = 0; i < total && !stream->isBroken;) {
+		int symbol = PackerDecode(stream, &lengthCode);
+		if (symbol < 16) {
+			lengths[i++] = (short)symbol;
+			continue;
+		}
+		short repeated = 0;
+		int repeat;
+		if (symbol == 16) { // Last length again
+			if (i == 0) {
+				stream->isBroken = 1;
+				return;
+			}
+			repeated = lengths[i - 1];
+			repeat = 3 + PackerBits(stream, 2);
+		} else if (symbol == 17) { // Zeros
+			repeat = 3 + PackerBits(stream, 3);
+		} else {
+			repeat = 11 + PackerBits(stream, 7);
+		}
+		if (i + repeat > total) {
+			stream->isBroken = 1;
+			return;
+		}
+		while (repeat--) {
+			lengths[i++] = repeated;
+		}
+	}
+	if (stream->isBroken || lengths[256] == 0 // A block has to be able to end
+		|| !PackerBuildHuffman(&literals, lengths, literalCount)
+		|| !PackerBuildHuffman(&distances, &lengths[literalCount], distanceCount)) {
+		stream->isBroken = 1;
+		return;
+	}
+	PackerInflateCodes(stream, &literals, &distances);
+}
+
+/// <summary>
+/// Inflates a zlib stream (2 byte header, deflate blocks) into a buffer of the size it should fill.
+/// </summary>
+/// <param name="data">zlib stream</param>
+/// <param name="size">Bytes in the stream</param>
+/// <param name="out">Buffer to inflate into</param>
+/// <param name="outSize">Bytes the stream has to inflate to</param>
+/// <returns>1 if the stream inflated to exactly outSize bytes, else 0</returns>
+int PackerInflate(const unsigned char* data, size_t size, unsigned char* out, size_t outSize) {
+	if (size < 2 || (data[0] & 0x0f) != 8 || ((data[0] << 8) | data[1]) % 31 != 0) { // Deflate, valid check bits
+		return 0;
+	}
+	struct Packer_Stream stream = { data, size, 2, 0, 0, out, outSize, 0, 0 };
+	int isLast;
+	do {
+		isLast = PackerBits(&stream, 1);
+		int type = PackerBits(&stream, 2);
+		if (type == 0) {
+			PackerInflateStored(&stream);
+		} else if (type == 1) {
+			PackerInflateFixed(&stream);
+		} else if (type == 2) {
+			PackerInflateDynamic(&stream);
+		} else {
+			stream.isBroken = 1;
+		}
+	} while (!isLast && !stream.isBroken);
+	return !stream.isBroken && stream.outPosition == outSize;
+}
+
+#pragma endregion
+
+#pragma region png
+
+unsigned int PackerReadBigEndian(const unsigned char* bytes) {
+	return ((unsigned int)bytes[0] << 24) | ((unsigned int)bytes[1] << 16) | ((unsigned int)bytes[2] << 8) | bytes[3];
+}
+
+int PackerPaeth(int left, int up, int upLeft) {
+	int estimate = left + up - upLeft;
+	int toLeft = abs(estimate - left), toUp = abs(estimate - up), toUpLeft = abs(estimate - upLeft);
+	return toLeft <= toUp && toLeft <= toUpLeft ? left : toUp <= toUpLeft ? up : upLeft;
+}
+
+/// <summary>
+/// Decodes a PNG file into RGBA pixels.
+/// </summary>
+/// <param name="file">Bytes of the file</param>
+/// <param name="size">Bytes in the file</param>
+/// <param name="image">Address of the Image to fill in, pixels are allocated with malloc</param>
+/// <returns>NULL if decoded, else what is wrong with the file</returns>
+const char* PackerDecodePng(const unsigned char* file, size_t size, struct Packer_Image* image) {
+	static const unsigned char signature[8] = { 137, 'P', 'N', 'G', 13, 10, 26, 10 };
+	if (size < 8 || memcmp(file, signature, 8) != 0) {
+		return "not a PNG";
+	}
+	unsigned int width = 0, height = 0;
+	int colorType = -1, channels = 0;
+	unsigned char palette[256][4];
+	for (int i = 0; i < 256; ++i) {
+		palette[i][0] = palette[i][1] = palette[i][2] = 0;
+		palette[i][3] = 255;
+	}
+	int transparentKey[3] = { -1, -1, -1 }; // Gray or RGB value that is see through, for color types 0 and 2
+	unsigned char* compressed = malloc(size); // IDAT chunks joined, never more than the file
+	size_t compressedSize = 0;
+	if (compressed == NULL) {
+		return "out of memory";
+	}
+
+	// Chunks
+	for (size_t position = 8; position + 12 <= size;) {
+		unsigned int length = PackerReadBigEndian(&file[position]);
+		const unsigned char* type = &file[position + 4];
+		const unsigned char* chunk = &file[position + 8];
+		if (length > size - position - 12) {
+			free(compressed);
+			return "chunk cut short";
+		}
+		if (memcmp(type, "IHDR", 4) == 0 && length >= 13) {
+			width = PackerReadBigEndian(chunk);
+			height = PackerReadBigEndian(chunk + 4);
+			colorType = chunk[9];
+			if (chunk[8] != 8 || chunk[12] != 0) {
+				free(compressed);
+				return "only 8 bit, not interlaced PNGs are packed";
+			}
+			channels = colorType == 0 ? 1 : colorType == 2 ? 3 : colorType == 3 ? 1 : colorType == 4 ? 2 : colorType == 6 ? 4 : 0;
+		} else if (memcmp(type, "PLTE", 4) == 0) {
+			for (unsigned int i = 0; i < length / 3 && i < 256; ++i) {
+				memcpy(palette[i], &chunk[i * 3], 3);
+			}
+		} else if (memcmp(type, "tRNS", 4) == 0) {
+			if (colorType == 3) {
+				for (unsigned int i = 0; i < length && i < 256; ++i) {
+					palette[i][3] = chunk[i];
+				}
+			} else {
+				for (unsigned int i = 0; i < 3 && i * 2 + 1 < length; ++i) {
+					transparentKey[i] = chunk[i * 2 + 1]; // Low byte, 8 bit images
+				}
+			}
+		} else if (memcmp(type, "IDAT", 4) == 0) {
+			memcpy(&compressed[compressedSize], chunk, length);
+			compressedSize += length;
+		} else if (memcmp(type, "IEND", 4) == 0) {
+			break;
+		}
+		position += 12 + (size_t)length; // Length, type, data and CRC
+	}
+	if (channels == 0 || width == 0 || height == 0 || width > PACK_MAX_SIZE || height > PACK_MAX_SIZE) {
+		free(compressed);
+		return "no IHDR, or a color type or size that is not supported";
+	}
+
+	// Inflate, one filter byte before each row
+	size_t stride = (size_t)width * channels;
+	size_t rawSize = (stride + 1) * height;
+	unsigned char* raw = malloc(rawSize);
+	image->pixels = malloc((size_t)width * height * 4);
+	if (raw == NULL || image->pixels == NULL || !PackerInflate(compressed, compressedSize, raw, rawSize)) {
+		free(compressed);
+		free(raw);
+		free(image->pixels);
+		image->pixels = NULL;
+		return "image data could not be inflated";
+	}
+	free(compressed);
+
+	// Unfilter in place, each row against the unfiltered row above it
+	for (unsigned int y = 0; y < height; ++y) {
+		unsigned char* row = &raw[y * (stride + 1) + 1];
+		const unsigned char* above = y > 0 ? row - (stride + 1) : NULL;
+		int filter = row[-1];
+		for (size_t x = 0; x < stride; ++x) {
+			int left = x >= (size_t)channels ? row[x - channels] : 0;
+			int up = above != NULL ? above[x] : 0;
+			int upLeft = above != NULL && x >= (size_t)channels ? above[x - channels] : 0;
+			int predicted = filter == 1 ? left : filter == 2 ? up : filter == 3 ? (left + up) / 2 : filter == 4 ? PackerPaeth(left, up, upLeft) : 0;
+			row[x] = (unsigned char)(row[x] + predicted);
+		}
+		if (filter > 4) {
+			free(raw);
+			free(image->pixels);
+			image->pixels = NULL;
+			return "unknown row filter";
+		}
+
+		// To RGBA
+		unsigned char* out = &image->pixels[(size_t)y * width * 4];
+		for (unsigned int x = 0; x < width; ++x, out += 4) {
+			const unsigned char* in = &row[(size_t)x * channels];
+			if (colorType == 3) {
+				memcpy(out, palette[in[0]], 4);
+			} else if (colorType == 0 || colorType == 4) {
+				out[0] = out[1] = out[2] = in[0];
+				out[3] = colorType == 4 ? in[1] : in[0] == transparentKey[0] ? 0 : 255;
+			} else {
+				out[0] = in[0];
+				out[1] = in[1];
+				out[2] = in[2];
+				out[3] = colorType == 6 ? in[3] : in[0] == transparentKey[0] && in[1] == transparentKey[1] && in[2] == transparentKey[2] ? 0 : 255;
+			}
+		}
+	}
+	free(raw);
+	image->width = width;
+	image->height = height;
+	return NULL;
+}
+
+#pragma endregion
+
+/// <summary>
+/// Reads a whole file.
+/// </summary>
+/// <param name="path">File path</param>
+/// <param name="size">Address of the size to fill in</param>
+/// <returns>Bytes of the file, allocated with malloc. NULL if it could not be read</returns>
+unsigned char* PackerReadFile(const char* path, size_t* size) {
+	FILE* file = fopen(path, "rb");
+	if (file == NULL) {
+		return NULL;
+	}
+	fseek(file, 0, SEEK_END);
+	long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	unsigned char* bytes = length > 0 ? malloc((size_t)length) : NULL;
+	if (bytes != NULL && fread(bytes, 1, (size_t)length, file) != (size_t)length) {
+		free(bytes);
+		bytes = NULL;
+	}
+	fclose(file);
+	*size = (size_t)length;
+	return bytes;
+}
+
+int PackerCompareEntries(const void* a, const void* b) {
+	return strcmp(((const struct Pack_Entry*)a)->path, ((const struct Pack_Entry*)b)->path);
+}
+
+/// <summary>
+/// Writes the pack: the header, the entries sorted by path, then the pixels in the order of the images.
+/// </summary>
+/// <param name="path">Pack File</param>
+/// <param name="images">Decoded Images</param>
+/// <param name="count">Number of Images</param>
+/// <returns>Bytes written, 0 if the file could not be written</returns>
+unsigned long long PackerWrite(const char* path, const struct Packer_Image images[], int count) {
+	struct Pack_Header header = { { 0 }, PACK_VERSION, (unsigned int)count, 0 };
+	memcpy(header.magic, PACK_MAGIC, sizeof(header.magic));
+	struct Pack_Entry* entries = calloc(count > 0 ? count : 1, sizeof(struct Pack_Entry));
+	if (entries == NULL) {
+		return 0;
+	}
+	unsigned long long offset = sizeof(header) + sizeof(struct Pack_Entry) * count;
+	for (int i = 0; i < count; ++i) {
+		offset = (offset + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+		strcpy(entries[i].path, images[i].path); // Shorter than PACK_PATH_SIZE, checked when read
+		entries[i].width = images[i].width;
+		entries[i].height = images[i].height;
+		entries[i].offset = offset;
+		entries[i].sourceSize = images[i].sourceSize;
+		entries[i].sourceTime = images[i].sourceTime;
+		offset += (unsigned long long)images[i].width * images[i].height * 4;
+	}
+	FILE* file = fopen(path, "wb");
+	if (file == NULL) {
+		free(entries);
+		return 0;
+	}
+	fwrite(&header, sizeof(header), 1, file);
+	struct Pack_Entry* sorted = malloc(sizeof(struct Pack_Entry) * (count > 0 ? count : 1));
+	int isWritten = sorted != NULL;
+	if (isWritten) {
+		memcpy(sorted, entries, sizeof(struct Pack_Entry) * count);
+		qsort(sorted, count, sizeof(struct Pack_Entry), PackerCompareEntries);
+		isWritten = fwrite(sorted, sizeof(struct Pack_Entry), count, file) == (size_t)count;
+		free(sorted);
+	}
+	static const unsigned char padding[PACK_ALIGNMENT] = { 0 };
+	for (int i = 0; i < count && isWritten; ++i) {
+		long position = ftell(file);
+		fwrite(padding, 1, (size_t)(entries[i].offset - position), file);
+		isWritten = fwrite(images[i].pixels, 4, (size_t)images[i].width * images[i].height, file) == (size_t)images[i].width * images[i].height;
+	}
+	isWritten = fclose(file) == 0 && isWritten;
+	free(entries);
+	return isWritten ? offset : 0;
+}
+
+int main(int argc, char* argv[]) {
+	const char* manifestPath = argc > 1 ? argv[1] : PACKER_MANIFEST;
+	const char* packPath = argc > 2 ? argv[2] : PACK_FILE;
+	FILE* manifest = fopen(manifestPath, "r");
+	if (manifest == NULL) {
+		printf("could not read manifest: %s\n", manifestPath);
+		return 1;
+	}
+
+	static struct Packer_Image images[PACKER_MAX_IMAGES];
+	int count = 0, skipped = 0;
+	size_t pngBytes = 0;
+	clock_t start = clock();
+	char line[PACK_PATH_SIZE + 16];
+	while (count < PACKER_MAX_IMAGES && fgets(line, sizeof(line), manifest) != NULL) {
+		line[strcspn(line, "\r\n")] = '\0';
+		if (strncmp(line, "image,", 6) != 0) { // Fonts and sounds are loaded as they are
+			continue;
+		}
+		const char* path = line + 6;
+		size_t size;
+		unsigned char* file = strlen(path) < PACK_PATH_SIZE ? PackerReadFile(path, &size) : NULL;
+		const char* error = file == NULL ? "could not be read (or the path is too long)" : PackerDecodePng(file, size, &images[count]);
+		free(file);
+		if (error != NULL) {
+			printf("%s: %s, left out\n", path, error);
+			skipped++;
+			continue;
+		}
+		strcpy(images[count].path, path);
+		Pack_GetStamp(path, &images[count].sourceSize, &images[count].sourceTime);
+		pngBytes += size;
+		count++;
+	}
+	fclose(manifest);
+
+	unsigned long long packBytes = PackerWrite(packPath, images, count);
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	for (int i = 0; i < count; ++i) {
+		free(images[i].pixels);
+	}
+	if (packBytes == 0) {
+		printf("could not write pack: %s\n", packPath);
+		return 1;
+	}
+	printf("packed: %d images (%d left out), %.1f MB of PNG into %.1f MB, %.3fs\n", count, skipped, pngBytes / 1e6, packBytes / 1e6, seconds);
+	return 0;
+}
@@ -6,6 +6,7 @@
 //		Added collision for game boundaries (Right/Left Wall Collision & Ceiling Collision)
 // l.zheneudamon 
 //		Added the IsPlayerStopped function to detect case of player inside the platform in the next frame
+//		Replaced IsPlayerStopped with SweepBox, which finds when a moving box first touches any of the platforms
 //
 // brief:
 // Contains the physics functions definitions that are used in the game to detect collision.
@@ -16,13 +17,14 @@
 // All Content  2023 DigiPen Institute of Technology Singapore, All rights reserved.
 //------------------------------------------------------------------------------------
 
+#include <float.h>
 #include <math.h>
 #include <stdio.h>
-#include "cprocessing.h"
 #include "initialize.h"
+#include "physics.h"
 
 int IsRightWallCollided(float playerX, float playerWidth, float wallWidth) {
-	float rightWall = CP_System_GetWindowWidth() - wallWidth;
+	float rightWall = WINDOW_WIDTH - wallWidth;
 	if (playerX + playerWidth / 2 > rightWall) {
 		return 1;
 	}
@@ -37,87 +39,71 @@ int IsLeftWallCollided(float playerX, float playerWidth, float wallWidth) {
 }
 
 int IsCeilingCollided(float playerY, float playerHeight, float maxY) {
-	maxY -= CP_System_GetWindowHeight() / 2.0f;
+	maxY -= WINDOW_HEIGHT / 2.0f;
 	if (playerY - playerHeight / 2 < maxY) {
 		return 1;
 	}
 	return 0;
 }
 
-int IsPlayerStopped(struct Player player, int scenario, float platfromCornerX, float platformCornerY) {
-	// This function should ONLY BE CALLED when the player is inside the platform in the next frame
+struct Physics_Contact SweepBox(float x, float y, float halfWidth, float halfHeight, float moveX, float moveY, const struct Physics_Box boxes[], int boxCount, int isOneWay) {
+	struct Physics_Contact contact = { 1.0f, 0.0f, 0.0f, -1 };
+	float firstTime = 2.0f; // Later than any contact
+	// An axis that does not move is either inside a box's slab for the whole move or never, so it is never divided by
+	float inverseX = moveX != 0 ? 1.0f / moveX : 0.0f;
+	float inverseY = moveY != 0 ? 1.0f / moveY : 0.0f;
 
-	float leftPlayer = player.x - player.height / 2.0f;
-	float rightPlayer = player.x + player.height / 2.0f;
-	float topPlayer = player.y - player.height / 2.0f;
-	float bottomPlayer = player.y + player.height / 2.0f;
+	for (int i = 0; i < boxCount; ++i) {
+		// Growing the box by the half size of the moving box turns the moving box into a point (its center)
+		float left = boxes[i].left - halfWidth;
+		float right = boxes[i].right + halfWidth;
+		float top = boxes[i].top - halfHeight;
+		float bottom = boxes[i].bottom + halfHeight;
 
-	// This code takes in player's corner coordinates
-	// as well as velocity to get next frame's coordinates
-	// And compares it with the given corner of platform 
+		// Times the center enters and leaves the slab between the sides of each axis
+		float leftTime = (left - x) * inverseX;
+		float rightTime = (right - x) * inverseX;
+		float topTime = (top - y) * inverseY;
+		float bottomTime = (bottom - y) * inverseY;
+		int isInsideX = (x > left) & (x < right);
+		int isInsideY = (y > top) & (y < bottom);
+		// Plain compares, fminf and fmaxf are calls unless NaNs are ruled out
+		float enterX = moveX != 0 ? (leftTime < rightTime ? leftTime : rightTime) : (isInsideX ? -FLT_MAX : FLT_MAX);
+		float leaveX = moveX != 0 ? (leftTime < rightTime ? rightTime : leftTime) : (isInsideX ? FLT_MAX : -FLT_MAX);
+		float enterY = moveY != 0 ? (topTime < bottomTime ? topTime : bottomTime) : (isInsideY ? -FLT_MAX : FLT_MAX);
+		float leaveY = moveY != 0 ? (topTime < bottomTime ? bottomTime : topTime) : (isInsideY ? FLT_MAX : -FLT_MAX);
 
-	// scenario determines which corner of the platfrom was given
-	// 1 is top left
-	// 2 is top right
-	// 3 is bottom left
-	// 4 is bottom right
+		// Inside the box once inside both slabs, until outside either
+		float enter = enterX > enterY ? enterX : enterY;
+		float leave = leaveX < leaveY ? leaveX : leaveY;
+		int isSide = enterX > enterY; // Corners count as landing on top (or hitting the bottom)
+		int isHit = (enter >= 0) & (enter <= 1) & (enter < leave) & (enter < firstTime);
+		isHit &= (isOneWay == 0) | ((isSide == 0) & (moveY > 0));
 
-	// First step: determine which corner was given basen on last player coordinates and platform coordinates
-	if (scenario == 1) { // Player is left of platform, moving downwards
-		// As player is moving towards its bottom right, BOTH hori velo and vert velo is +ve
-		float distanceToPlatformX = platfromCornerX - rightPlayer; // Always +ve (if player is not directly under Platform)
-		float distanceToPlatformY = platformCornerY - bottomPlayer; // Might be -ve
-		float playerDistanceCoveredX = player.horizontalVelocity * CP_System_GetDt();
-		float playerDistanceCoveredY = player.verticalVelocity * CP_System_GetDt();
-
-		float ratioOfDistance = distanceToPlatformX / distanceToPlatformY;
-		float ratioOfPlayerDistance = playerDistanceCoveredX / playerDistanceCoveredY;
-		if (ratioOfDistance > ratioOfPlayerDistance) { // Player Y ratio higher than X. Player Face Plant
-			return 1;
-		} else { // Player X ratio higher than Y. Player landed on platform first
-			return 0;
-		}
-	} else if (scenario == 2) { // Player is right of platform, moving downwards
-		// As player is moving towards its bottom left, hori velo is -ve and vert velo is +ve
-		float distanceToPlatformX = leftPlayer - platfromCornerX; // Always +ve (if player is not directly under Platform)
-		float distanceToPlatformY = platformCornerY - bottomPlayer; // Always +ve
-		float playerDistanceCoveredX = -player.horizontalVelocity * CP_System_GetDt(); // Set to Positive
-		float playerDistanceCoveredY = player.verticalVelocity * CP_System_GetDt();
+		firstTime = isHit ? enter : firstTime;
+		contact.box = isHit ? i : contact.box;
+		contact.normalX = isHit ? (isSide ? (moveX > 0 ? -1.0f : 1.0f) : 0.0f) : contact.normalX;
+		contact.normalY = isHit ? (isSide ? 0.0f : (moveY > 0 ? -1.0f : 1.0f)) : contact.normalY;
+	}
 
-		float ratioOfDistance = distanceToPlatformX / distanceToPlatformY;
-		float ratioOfPlayerDistance = playerDistanceCoveredX / playerDistanceCoveredY;
-		if (ratioOfDistance > ratioOfPlayerDistance) { // Player Y ratio higher than X. Player Face Plant
-			return 1;
-		} else { // Player X ratio higher than Y-> Player landed on platform first->
-			return 0;
-		}
-	} else if (scenario == 3) { // Player is left of platform, moving upwards
-		// As player is moving towards its top right, hori velo is +ve and vert velo is -ve
-		float distanceToPlatformX = platfromCornerX - rightPlayer; // Always +ve (if player is not directly under Platform)
-		float distanceToPlatformY = topPlayer - platformCornerY; // Might be -ve
-		float playerDistanceCoveredX = player.horizontalVelocity * CP_System_GetDt();
-		float playerDistanceCoveredY = -player.verticalVelocity * CP_System_GetDt(); // Set to Postive for calculating distance
+	contact.time = contact.box >= 0 ? firstTime : 1.0f;
+	return contact;
+}
 
-		float ratioOfDistance = distanceToPlatformX / distanceToPlatformY;
-		float ratioOfPlayerDistance = playerDistanceCoveredX / playerDistanceCoveredY;
-		if (ratioOfDistance > ratioOfPlayerDistance) { // Player Y ratio higher than X. Player Face Plant
-			return 1;
-		} else { // Player X ratio higher than Y. Player head hit platform first
-			return 0;
+int GetOverlappedBox(float x, float y, float halfWidth, float halfHeight, const struct Physics_Box boxes[], int boxCount) {
+	for (int i = 0; i < boxCount; ++i) {
+		if (x > boxes[i].left - halfWidth && x < boxes[i].right + halfWidth && y > boxes[i].top - halfHeight && y < boxes[i].bottom + halfHeight) {
+			return i;
 		}
-	} else { // (scenario == 4) Player is right of platform, moving upwards
-		// As player is moving towards its top left, BOTH hori velo and vert velo is -ve
-		float distanceToPlatformX = leftPlayer - platfromCornerX; // Always +ve (if player is not directly under Platform)
-		float distanceToPlatformY = topPlayer - platformCornerY; // Might be -ve
-		float playerDistanceCoveredX = -player.horizontalVelocity * CP_System_GetDt(); // Set to Postive for calculating distance
-		float playerDistanceCoveredY = -player.verticalVelocity * CP_System_GetDt(); // Set to Postive for calculating distance
+	}
+	return -1;
+}
 
-		float ratioOfDistance = distanceToPlatformX / distanceToPlatformY;
-		float ratioOfPlayerDistance = playerDistanceCoveredX / playerDistanceCoveredY;
-		if (ratioOfDistance > ratioOfPlayerDistance) { // Player Y ratio higher than X Player Face Plant
-			return 1;
-		} else { // Player X ratio higher than Y. Player head hit platform first
-			return 0;
-		}
+int IsStandingOnBox(float x, float y, float halfWidth, float halfHeight, const struct Physics_Box boxes[], int boxCount) {
+	int isStanding = 0;
+	for (int i = 0; i < boxCount; ++i) {
+		// Same sums as SweepBox, so a box placed on a top by a contact is standing on it exactly
+		isStanding |= (y == boxes[i].top - halfHeight) & (x > boxes[i].left - halfWidth) & (x < boxes[i].right + halfWidth);
 	}
+	return isStanding;
 }
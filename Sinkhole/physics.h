@@ -9,6 +9,7 @@
 //		Added IsCeilingCollided()
 // l.zheneudamon 
 //		Added IsPlayerStopped()
+//		Replaced IsPlayerStopped() with SweepBox(), a swept box time of impact solver
 //
 // brief:
 // Contains the physics functions headers that are used in the game to detect collision.
@@ -46,18 +47,58 @@ int IsLeftWallCollided(float playerX, float playerWidth, float wallWidth);
 /// <returns> 1 (collided) or 0 (not collided) </returns>
 int IsCeilingCollided(float playerY, float playerHeight, float ceilingHeight);
 
+enum {
+	PHYSICS_MAX_SLIDES = 2, // Sweeps per move, after hitting something the rest of the move slides along it
+};
+
+struct Physics_Box {
+	float left, top, right, bottom;
+};
+
+struct Physics_Contact {
+	float time; // Fraction of the move done before touching, 1 if nothing was hit
+	float normalX, normalY; // Points out of the side that was hit (-1, 0 or 1), 0 if nothing was hit
+	int box; // Index of the box that was hit, -1 if nothing was hit
+};
+
+/// <summary>
+/// Sweeps a moving box against still boxes and finds the first one it touches.
+/// Boxes it already overlaps are ignored, so it can always move out of them.
+/// Boxes it only touches are hit if it moves into them, but not if it moves along them.
+/// No move is too fast to be caught, there is no tunnelling.
+/// </summary>
+/// <param name="x"> X Coordinate of the Center of the Moving Box </param>
+/// <param name="y"> Y Coordinate of the Center of the Moving Box </param>
+/// <param name="halfWidth"> Half the Width of the Moving Box </param>
+/// <param name="halfHeight"> Half the Height of the Moving Box </param>
+/// <param name="moveX"> Distance moved along X </param>
+/// <param name="moveY"> Distance moved along Y </param>
+/// <param name="boxes"> Array of Boxes </param>
+/// <param name="boxCount"> Number of Boxes </param>
+/// <param name="isOneWay"> 1 to only hit the tops of boxes while moving down (platforms that can be jumped through), else 0 </param>
+/// <returns> First Contact, time 1 and box -1 if nothing was hit </returns>
+struct Physics_Contact SweepBox(float x, float y, float halfWidth, float halfHeight, float moveX, float moveY, const struct Physics_Box boxes[], int boxCount, int isOneWay);
+
+/// <summary>
+/// Finds a box that the box overlaps. Touching is not overlapping.
+/// </summary>
+/// <param name="x"> X Coordinate of the Center of the Box </param>
+/// <param name="y"> Y Coordinate of the Center of the Box </param>
+/// <param name="halfWidth"> Half the Width of the Box </param>
+/// <param name="halfHeight"> Half the Height of the Box </param>
+/// <param name="boxes"> Array of Boxes </param>
+/// <param name="boxCount"> Number of Boxes </param>
+/// <returns> Index of the Box, -1 if none </returns>
+int GetOverlappedBox(float x, float y, float halfWidth, float halfHeight, const struct Physics_Box boxes[], int boxCount);
+
 /// <summary>
-/// Determines if player is halted horizontally or vertically.
-/// ONLY CALL THIS FUNCTION WHEN player's next frame is inside a platform.
+/// Checks if the bottom of the box is on the top of any of the boxes.
 /// </summary>
-/// <param name="player"> Player </param>
-/// <param name="scenario">
-/// 1 if player is moving bottom right, platform corner is top left.
-/// 2 if player is moving bottom left, platform corner is top right.
-/// 3 if player is moving top right, platform corner is bottom left.
-/// 4 if player is moving top left, platform corner is bottom right.
-/// </param>
-/// <param name="platfromCornerX"> X Coordinate of Platform Corner, based on Scenario </param>
-/// <param name="platformCornerY"> Y Coordinate of Platform Corner, based on Scenario </param>
-/// <returns> 1 if faceplanted, else 0 </returns>
-int IsPlayerStopped(struct Player player, int scenario, float platfromCornerX, float platformCornerY);
+/// <param name="x"> X Coordinate of the Center of the Box </param>
+/// <param name="y"> Y Coordinate of the Center of the Box </param>
+/// <param name="halfWidth"> Half the Width of the Box </param>
+/// <param name="halfHeight"> Half the Height of the Box </param>
+/// <param name="boxes"> Array of Boxes </param>
+/// <param name="boxCount"> Number of Boxes </param>
+/// <returns> 1 (standing) or 0 (not standing) </returns>
+int IsStandingOnBox(float x, float y, float halfWidth, float halfHeight, const struct Physics_Box boxes[], int boxCount);
@@ -4,6 +4,8 @@
 // authors:
 // l.zheneudamon (primary author)
 //		Added all pickups menu functions
+//		Changed Pickups to spawn from and go through their Pool
+//		Changed Pickups to be tested against the Player in one batch
 //
 // brief:
 // Contains functions used for pickups.
@@ -14,49 +16,59 @@
 // All Content  2023 DigiPen Institute of Technology Singapore, All rights reserved.
 //------------------------------------------------------------------------------------
 
-#include "cprocessing.h"
 #include "initialize.h"
 #include "utils.h"
+#include "pool.h"
+#include "collide.h"
 
-void SpawnHealthPickup(struct Pickups pickups[], float pickupX, float pickupY, int percent) {
-	int rng = RandomNumber(0, 99);
+void SpawnHealthPickup(struct GameWorld* world, float pickupX, float pickupY, int percent) {
+	int rng = RandomNumber(&world->rng[RNG_STREAM_PICKUPS], 0, 99);
 	if (rng < percent) {
-		for (int i = 0; i < MAX_HEALTH_PICKUPS; ++i) {
-			if (!pickups[i].isActive) {
-				pickups[i].isActive = 1;
-				pickups[i].x = pickupX;
-				pickups[i].y = pickupY;
-				pickups[i].imageSize = PICKUP_SIZE;
-				break;
-			}
+		int i = PoolSpawn(&world->pickupPool, MAX_HEALTH_PICKUPS); // Lowest inactive pickup
+		if (i >= 0) {
+			struct Pickups* pickup = &world->pickups[i];
+			pickup->x = pickupX;
+			pickup->y = pickupY;
+			pickup->imageSize = PICKUP_SIZE;
 		}
 	}
 }
 
-int CheckPlayerPickedUpHealth(struct Player player, struct Pickups pickups[]) { // Returns 1 if Player gain health
-	for (int i = 0; i < MAX_HEALTH_PICKUPS; ++i) {
-		if (pickups[i].isActive && AreRectanglesIntersecting(player.x, player.y, player.width, player.height, pickups[i].x, pickups[i].y, pickups[i].imageSize, pickups[i].imageSize)) {
-			if (player.currentHealth != player.maxHealth){
-				pickups[i].isActive = 0;
-				return 1; // Bug/Feature: Only 1 pickup per frame
-			}
-		}
+int CheckPlayerPickedUpHealth(struct GameWorld* world) { // Returns 1 if Player gain health
+	struct Entity_Pool* pool = &world->pickupPool;
+	struct Pickups* pickups = world->pickups;
+	struct Player* player = &world->player;
+	if (player->currentHealth == player->maxHealth) {
+		return 0;
 	}
-	return 0;
-}
-
-void DespawnHealthPickup(struct Pickups pickups[], float maxY) {
-	for (int i = 0; i < MAX_HEALTH_PICKUPS; ++i) {
-		if (pickups[i].isActive && pickups[i].y < maxY - CP_System_GetWindowHeight()) {
-			pickups[i].isActive = 0;
+	for (int first = 0; first < MAX_HEALTH_PICKUPS; first += COLLIDE_BATCH) {
+		int count = MAX_HEALTH_PICKUPS - first < COLLIDE_BATCH ? MAX_HEALTH_PICKUPS - first : COLLIDE_BATCH;
+		unsigned int live = PoolsBits(pool, first, count);
+		if (!live) {
+			continue;
+		}
+		count = CollideCount(live); // Up to the last slot in use
+		float xs[COLLIDE_BATCH], ys[COLLIDE_BATCH], sizes[COLLIDE_BATCH];
+		for (int k = 0; k < count; ++k) { // Free slots are tested too, their bits are left out
+			xs[k] = pickups[first + k].x;
+			ys[k] = pickups[first + k].y;
+			sizes[k] = pickups[first + k].imageSize;
+		}
+		unsigned int touched = RectHitsRects(player->x, player->y, player->width, player->height, xs, ys, sizes, sizes, count) & live;
+		if (touched) {
+			PoolDespawn(pool, first + CollideFirst(touched));
+			return 1; // Bug/Feature: Only 1 pickup per frame
 		}
 	}
+	return 0;
 }
 
-void AnimatePickupHealths(struct Pickups pickups[], CP_Image pickupsHealth[], float gameTimer) {
-	for (int i = 0; i < MAX_HEALTH_PICKUPS; ++i) {
-		if (pickups[i].isActive) {
-			pickups[i].imageAddress = GetAnimationImageAddress(pickupsHealth, MAX_FRAME_PICKUP_HEALTH, gameTimer);
+void DespawnHealthPickup(struct GameWorld* world) {
+	struct Entity_Pool* pool = &world->pickupPool;
+	struct Pickups* pickups = world->pickups;
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		if (pickups[i].y < world->maxY - WINDOW_HEIGHT) {
+			PoolDespawn(pool, i);
 		}
 	}
 }
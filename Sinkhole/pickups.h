@@ -18,31 +18,21 @@
 /// <summary>
 /// Spawns a Health Pickup.
 /// </summary>
-/// <param name="pickups">Array of Pickups</param>
+/// <param name="world">Address of Game World</param>
 /// <param name="pickupX">Spawning X Coordinate</param>
 /// <param name="pickupY">Spawning Y Coordinate</param>
-/// <param name="pickupSize">Size of Pickup</param>
 /// <param name="percent">Number from 0 - 100 to determine chance of spawning</param>
-void SpawnHealthPickup(struct Pickups pickups[], float pickupX, float pickupY, int percent);
+void SpawnHealthPickup(struct GameWorld* world, float pickupX, float pickupY, int percent);
 
 /// <summary>
 /// Checks if the Player has picked up a Pickup.
 /// </summary>
-/// <param name="player">Player</param>
-/// <param name="pickups">Array of Pickups</param>
+/// <param name="world">Address of Game World</param>
 /// <returns>1 if the Player picked up a Pickup</returns>
-int CheckPlayerPickedUpHealth(struct Player player, struct Pickups pickups[]);
+int CheckPlayerPickedUpHealth(struct GameWorld* world);
 
 /// <summary>
 /// Sets Pickups to 0.
 /// </summary>
-/// <param name="pickups">Array of Pickups</param>
-/// <param name="maxY">Midpoint of the screen Y</param>
-void DespawnHealthPickup(struct Pickups pickups[], float maxY);
-
-/// <summary>
-/// Changes the address of pickup images that are active.
-/// </summary>
-/// <param name="pickups">Array of Pickups</param>
-/// <param name="gameTimer">Timer that increases per frame</param>
-void AnimatePickupHealths(struct Pickups pickups[], CP_Image pickupsHealth[], float gameTimer);
+/// <param name="world">Address of Game World</param>
+void DespawnHealthPickup(struct GameWorld* world);
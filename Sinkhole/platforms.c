@@ -5,6 +5,13 @@
 // timo.duethorn (primary author)
 //		Added function to randomly generate a new platform
 //		Added function to shift platforms through an array and generate a new platform at the end of the array
+// l.zheneudamon
+//		Added function to get the boxes of the platforms for the physics
+//		Changed rows to sorted segments, added binary search lookups
+//		Changed the rows to a ring buffer, added lookahead rows
+//		Added precomputed edges to the rows
+//		Changed rows to only depend on the seed and their y
+//		Added the queue of rows built ahead, with walking enemy spawn rolls
 // 
 // brief:
 // Contains platform related functions.
@@ -16,121 +23,205 @@
 //------------------------------------------------------------------------------------
 
 #include "stdio.h" // For printf
-#include "cprocessing.h"
 #include "initialize.h"
+#include "physics.h"
+#include "platforms.h"
 #include "utils.h"
 
-void GeneratePlatform(struct Player player, struct Platform platforms[], int i, float wallWidth) {
-	int startValue = RandomNumber(0, 1);
-
-	if (platforms[i].y > 20 + (50 * player.totalUpgrades) && platforms[i].y < 30 + (50 * player.totalUpgrades)) {
-		platforms[i].start = 2;
-	} else {
-		platforms[i].start = startValue;
-	}
+void GeneratePlatformRow(struct Platform* platform, unsigned long long seed, int y, float wallWidth, float platformHeight) {
+	struct Rng rowRng; // Only this row draws from it, so rows can be made in any order
+	struct Rng* rng = &rowRng;
+	SeedRandomAt(rng, seed, RNG_STREAM_PLATFORMS, y);
+	int startValue = RandomNumber(rng, 0, 1);
 
 	int playableSpace = 960;
 	int minPlatform = 250;
 	int minGap = 175;
 
-	if (platforms[i].start == 0) { // Start with Platform
-		int remainder = playableSpace;
-		int platformWidth1 = RandomNumber(minPlatform, remainder - minGap);
-		platforms[i].p1Length = platformWidth1;
-		platforms[i].p1Coord = platformWidth1 / 2.0f + wallWidth;
-		remainder = remainder - platformWidth1;
-
-		if (remainder < minPlatform + minGap) { // 1 Platform, 1 Gap
-			platforms[i].g1Length = remainder;
-			platforms[i].p2Length = 0;
-			platforms[i].p2Coord = (float)CP_System_GetWindowWidth();
-			platforms[i].g2Length = 0;
-		} else if (remainder > 0) { // 1 Platform, 1 Gap & more
-			int gapWidth1 = RandomNumber(minGap, remainder - minPlatform);
-			platforms[i].g1Length = gapWidth1;
-			remainder = remainder - gapWidth1;
-
-			if (remainder < minPlatform + minGap) { // 1 Platform, 1 Gap, 1 Platform
-				platforms[i].p2Length = remainder;
-				platforms[i].p2Coord = remainder / 2.0f + wallWidth + platformWidth1 + gapWidth1;
-				platforms[i].g2Length = 0;
-			} else if (remainder > 0) { // 1 Platform, 1 Gap, 1 Platform, 1 Gap
-				int platformWidth2 = RandomNumber(minPlatform, remainder - minGap);
-				platforms[i].p2Length = platformWidth2;
-				platforms[i].p2Coord = platformWidth2 / 2.0f + wallWidth + platformWidth1 + gapWidth1;
-				remainder = remainder - platformWidth2;
-
-				platforms[i].g2Length = remainder;
+	platform->y = y;
+	platform->top = y * 100 - platformHeight / 2.0f;
+	platform->bottom = y * 100 + platformHeight / 2.0f;
+	platform->segmentCount = 0;
+	if (y > 20 && (y - 20) % 50 > 0 && (y - 20) % 50 < 10) {
+		// Generate Empty Layer / No Platforms (The player falls through these after each upgrade, every 50 rows from row 20)
+	} else {
+		// Alternate platforms and gaps from the left wall, each at least its minimum,
+		// and leave room for the next one or take the rest of the row
+		int isPlatform = startValue == 0; // Start with Platform or Gap
+		int used = 0;
+		while (used < playableSpace) {
+			int remainder = playableSpace - used;
+			int minWidth = isPlatform ? minPlatform : minGap;
+			int minNext = isPlatform ? minGap : minPlatform;
+			int width = remainder;
+			if (remainder >= minWidth + minNext) {
+				width = RandomNumber(rng, minWidth, remainder - minNext);
 			}
-		}
-	} else if (platforms[i].start == 1) { // Start with Gap
-		int remainder = playableSpace;
-		int gapWidth1 = RandomNumber(minGap, remainder - minPlatform);
-		platforms[i].g1Length = gapWidth1;
-		remainder = remainder - gapWidth1;
-
-		if (remainder < minGap + minPlatform) { // 1 Gap, 1 Platform
-			platforms[i].p1Length = remainder;
-			platforms[i].p1Coord = remainder / 2.0f + wallWidth + gapWidth1;
-			platforms[i].p2Length = 0;
-			platforms[i].p2Coord = (float)CP_System_GetWindowWidth();
-			platforms[i].g2Length = 0;
-		} else if (remainder > 0) { // 1 Gap, 1 Platform & more
-			int platformWidth1 = RandomNumber(minPlatform, remainder - minGap);
-			platforms[i].p1Length = platformWidth1;
-			platforms[i].p1Coord = platformWidth1 / 2.0f + wallWidth + gapWidth1;
-			remainder = remainder - platformWidth1;
-
-			if (remainder < minGap + minPlatform) { // 1 Gap, 1 Platform, 1 Gap
-				platforms[i].g2Length = remainder;
-				platforms[i].p2Length = 0;
-				platforms[i].p2Coord = (float)CP_System_GetWindowWidth();
-			} else if (remainder > 0) { // 1 Gap, 1 Platform, 1 Gap, 1 Platform
-				int gapWidth2 = RandomNumber(minGap, remainder - minPlatform);
-				platforms[i].g2Length = gapWidth2;
-				remainder = remainder - gapWidth2;
-
-				platforms[i].p2Length = remainder;
-				platforms[i].p2Coord = remainder / 2.0f + wallWidth + gapWidth1 + platformWidth1 + gapWidth2;
+
+			if (isPlatform && platform->segmentCount < MAX_PLATFORM_SEGMENTS) {
+				platform->left[platform->segmentCount] = wallWidth + used;
+				platform->right[platform->segmentCount] = wallWidth + used + width;
+				platform->segmentCount++;
 			}
+			used += width;
+			isPlatform = !isPlatform;
 		}
-	} else if (platforms[i].start == 2) { // platforms data = 0; Generate Empty Layer / No Platforms
-		platforms[i].g1Length = 0;
-		platforms[i].p1Length = 0;
-		platforms[i].p1Coord = 0.0;
-		platforms[i].g2Length = 0;
-		platforms[i].p2Length = 0;
-		platforms[i].p2Coord = (float)CP_System_GetWindowWidth();
 	}
 
-	if (platforms[i].y == 5) { // First Platform Data
-		platforms[i].start = 1;
-		platforms[i].g1Length = 300;
-		platforms[i].p1Length = 360;
-		platforms[i].p1Coord = 800.0;
-		platforms[i].g2Length = 300;
-		platforms[i].p2Length = 0;
-		platforms[i].p2Coord = (float)CP_System_GetWindowWidth();
+	if (y == 5) { // First Platform Data
+		platform->segmentCount = 1;
+		platform->left[0] = 620.0;
+		platform->right[0] = 980.0;
+	}
+
+	if (y == 7) { // Second Platform Data
+		platform->segmentCount = 2;
+		platform->left[0] = 320.0;
+		platform->right[0] = 620.0;
+		platform->left[1] = 980.0;
+		platform->right[1] = 1280.0;
+	}
+
+	// Walking enemy rolls come from a stream of their own, so the layout does not depend on them
+	struct Rng spawnRng;
+	SeedRandomAt(&spawnRng, seed, RNG_STREAM_ENEMIES, y);
+	platform->spawnChance = (unsigned char)RandomNumber(&spawnRng, 0, 99);
+	platform->spawnCount = (unsigned char)RandomNumber(&spawnRng, 0, 99);
+	for (int j = 0; j < PLATFORM_SPAWN_SLOTS; ++j) {
+		platform->spawnX[j] = (unsigned char)RandomNumber(&spawnRng, 0, 99);
+		platform->spawnSegment[j] = (unsigned char)RandomNumber(&spawnRng, 0, platform->segmentCount > 0 ? platform->segmentCount - 1 : 0);
+	}
+}
+
+void GeneratePlatform(struct GameWorld* world, int i) {
+	struct Platform* platform = &world->platforms[(world->platformHead + i) & (MAX_PLATFORMS - 1)];
+	GeneratePlatformRow(platform, world->seed, platform->y, world->wallWidth, world->platformHeight);
+}
+
+void ShiftPlatform(struct GameWorld* world, int newY) {
+	// The top row is dropped by moving the head, and its slot is reused for the new bottom row
+	world->platformHead = (world->platformHead + 1) & (MAX_PLATFORMS - 1);
+	int i = world->platformCount - 1;
+	struct Platform* platform = &world->platforms[(world->platformHead + i) & (MAX_PLATFORMS - 1)];
+
+	struct Platform_Queue* queue = &world->platformQueue;
+	while (queue->count > 0 && queue->rows[queue->head].y < newY) { // Rows that were skipped (falling to an upgrade)
+		queue->head = (queue->head + 1) & (PLATFORM_QUEUE_ROWS - 1);
+		queue->count--;
+	}
+	if (queue->count > 0 && queue->rows[queue->head].y == newY) { // Built ahead, rows only depend on the seed and y so it is the same row
+		*platform = queue->rows[queue->head];
+		queue->head = (queue->head + 1) & (PLATFORM_QUEUE_ROWS - 1);
+		queue->count--;
+	} else {
+		platform->y = newY;
+		GeneratePlatform(world, i);
+		ResetPlatformQueue(world);
+	}
+}
+
+void ResetPlatformQueue(struct GameWorld* world) {
+	struct Platform_Queue* queue = &world->platformQueue;
+	queue->head = 0;
+	queue->count = 0;
+	queue->nextY = GetPlatformRow(world, world->platformCount - 1)->y + world->distanceBetweenPlatform;
+}
+
+void BuildQueuedPlatform(struct GameWorld* world) {
+	struct Platform_Queue* queue = &world->platformQueue;
+	if (queue->count < PLATFORM_QUEUE_ROWS) {
+		struct Platform* platform = &queue->rows[(queue->head + queue->count) & (PLATFORM_QUEUE_ROWS - 1)];
+		GeneratePlatformRow(platform, world->seed, queue->nextY, world->wallWidth, world->platformHeight);
+		queue->count++;
+		queue->nextY += world->distanceBetweenPlatform;
+	}
+}
+
+void SetPlatformLookahead(struct GameWorld* world, int rows) {
+	if (rows < 0) {
+		rows = 0;
+	} else if (rows > MAX_PLATFORMS - PLATFORM_WINDOW_ROWS) {
+		rows = MAX_PLATFORMS - PLATFORM_WINDOW_ROWS;
+	}
+	int count = PLATFORM_WINDOW_ROWS + rows;
+	while (world->platformCount < count) { // Generate the new rows below the bottom row
+		int i = world->platformCount++;
+		world->platforms[(world->platformHead + i) & (MAX_PLATFORMS - 1)].y = GetPlatformRow(world, i - 1)->y + world->distanceBetweenPlatform;
+		GeneratePlatform(world, i);
 	}
+	world->platformCount = count;
+	ResetPlatformQueue(world);
+}
 
-	if (platforms[i].y == 7) { // Second Platform Data
-		platforms[i].start = 0;
-		platforms[i].g1Length = 360;
-		platforms[i].p1Length = 300;
-		platforms[i].p1Coord = 470.0;
-		platforms[i].g2Length = 0;
-		platforms[i].p2Length = 300;
-		platforms[i].p2Coord = 1130.0;
+const struct Platform* GetPlatformRow(const struct GameWorld* world, int i) {
+	return &world->platforms[(world->platformHead + i) & (MAX_PLATFORMS - 1)];
+}
+
+#pragma region Lookups
+
+// Index of the first segment that ends after x (or at x, if isTouching), segmentCount if none
+static int FirstSegmentEndingAfter(const struct Platform* platform, float x, int isTouching) {
+	int low = 0, high = platform->segmentCount;
+	while (low < high) {
+		int middle = (low + high) / 2;
+		float right = platform->right[middle];
+		if (right > x || (isTouching && right == x)) {
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
 	}
+	return low;
 }
 
-void ShiftPlatform(struct Player player, struct Platform platforms[], int drawnPlatforms, int newY, float wallWidth) {
-	for (int i = 0, j = 1; i < drawnPlatforms; ++i, ++j) {
-		if (i != (drawnPlatforms - 1)) {
-			platforms[i] = platforms[j];
+// Index of the first segment that starts after x, segmentCount if none
+static int FirstSegmentStartingAfter(const struct Platform* platform, float x) {
+	int low = 0, high = platform->segmentCount;
+	while (low < high) {
+		int middle = (low + high) / 2;
+		if (platform->left[middle] > x) {
+			high = middle;
 		} else {
-			platforms[i].y = newY;
-			GeneratePlatform(player, platforms, i, wallWidth);
+			low = middle + 1;
 		}
 	}
+	return low;
 }
+
+int FindPlatformSegment(const struct Platform* platform, float x) {
+	int i = FirstSegmentEndingAfter(platform, x, 0);
+	if (i < platform->segmentCount && platform->left[i] <= x) {
+		return i;
+	}
+	return -1;
+}
+
+int FindPlatformSegments(const struct Platform* platform, float left, float right, int* first) {
+	*first = FirstSegmentEndingAfter(platform, left, 1);
+	int end = FirstSegmentStartingAfter(platform, right);
+	return end > *first ? end - *first : 0;
+}
+
+int GetPlatformBoxes(const struct GameWorld* world, float areaLeft, float areaTop, float areaRight, float areaBottom, struct Physics_Box* boxes) {
+	int count = 0;
+	for (int i = 0; i < world->platformCount; ++i) {
+		const struct Platform* platform = GetPlatformRow(world, i);
+		if (platform->top > areaBottom) { // Rows are sorted top to bottom, the rest are further down
+			break;
+		} else if (platform->bottom < areaTop) {
+			continue;
+		}
+		int first;
+		int segmentCount = FindPlatformSegments(platform, areaLeft, areaRight, &first);
+		for (int j = first; j < first + segmentCount; ++j) {
+			boxes[count].left = platform->left[j];
+			boxes[count].right = platform->right[j];
+			boxes[count].top = platform->top;
+			boxes[count].bottom = platform->bottom;
+			count++;
+		}
+	}
+	return count;
+}
+
+#pragma endregion
@@ -15,18 +15,90 @@
 // All Content  2023 DigiPen Institute of Technology Singapore, All rights reserved.
 //------------------------------------------------------------------------------------
 
+struct Physics_Box; // Defined in physics.h
+
 /// <summary>
-/// Randomly generates platform data at last value of platforms array.
+/// Randomly generates platform data (and the walking enemy spawn rolls) for the row at a y. The row only depends on the seed and y,
+/// so rows can be generated in any order, or ahead of time.
 /// </summary>
-/// <param name="platforms"> Array of Platforms </param>
-/// <param name="i"> Iterator </param>
+/// <param name="platform"> Address of the Platform row to fill in </param>
+/// <param name="seed"> Seed of the run </param>
+/// <param name="y"> Y value of the row (in 100s of pixels) </param>
 /// <param name="wallWidth"> Side Wall Width </param>
-void GeneratePlatform(struct Player player, struct Platform platforms[], int i, float wallWidth);
+/// <param name="platformHeight"> The actual pixel height of each individual Platform </param>
+void GeneratePlatformRow(struct Platform* platform, unsigned long long seed, int y, float wallWidth, float platformHeight);
+
+/// <summary>
+/// Randomly generates platform data for a row of the ring buffer, its y has to be set first.
+/// </summary>
+/// <param name="world"> Address of Game World </param>
+/// <param name="i"> Row from the top </param>
+void GeneratePlatform(struct GameWorld* world, int i);
+
+/// <summary>
+///	Drops the top row and adds a new row below the bottom one, from the Platform Queue if it was built ahead.
+/// Only the head of the ring buffer moves, the rows are not shifted.
+/// </summary>
+/// <param name="world"> Address of Game World </param>
+/// <param name="newY"> Y value of newly generated Platform </param>
+void ShiftPlatform(struct GameWorld* world, int newY);
+
+/// <summary>
+/// Empties the Platform Queue, the next row it builds goes below the bottom row.
+/// </summary>
+/// <param name="world"> Address of Game World </param>
+void ResetPlatformQueue(struct GameWorld* world);
+
+/// <summary>
+/// Builds one row into the Platform Queue, unless it is full. Called on steps that do not reach a new row,
+/// so the steps that do (which also spawn walking enemies) only copy a row that is already built.
+/// </summary>
+/// <param name="world"> Address of Game World </param>
+void BuildQueuedPlatform(struct GameWorld* world);
+
+/// <summary>
+/// Sets how many rows are generated ahead, below the PLATFORM_WINDOW_ROWS around the player (0 after Sim_Init).
+/// Missing rows are generated straight away, each distanceBetweenPlatform below the last.
+/// </summary>
+/// <param name="world"> Address of Game World </param>
+/// <param name="rows"> Rows of lookahead, up to MAX_PLATFORMS - PLATFORM_WINDOW_ROWS </param>
+void SetPlatformLookahead(struct GameWorld* world, int rows);
+
+/// <summary>
+/// Gets a row of the ring buffer.
+/// </summary>
+/// <param name="world"> Address of Game World </param>
+/// <param name="i"> Row from the top, up to platformCount - 1 </param>
+/// <returns> Address of the Platform row </returns>
+const struct Platform* GetPlatformRow(const struct GameWorld* world, int i);
+
+/// <summary>
+/// Finds the segment of a row that x is on, with a binary search.
+/// </summary>
+/// <param name="platform"> Address of the Platform row </param>
+/// <param name="x"> X value to look up </param>
+/// <returns> Index of the Segment with left <= x < right, -1 if x is over a gap </returns>
+int FindPlatformSegment(const struct Platform* platform, float x);
+
+/// <summary>
+/// Finds the segments of a row that reach between left and right (touching counts), with a binary search.
+/// They are always next to each other in the left and right arrays.
+/// </summary>
+/// <param name="platform"> Address of the Platform row </param>
+/// <param name="left"> X value of the left of the range </param>
+/// <param name="right"> X value of the right of the range </param>
+/// <param name="first"> Address of the Index of the first Segment found. This will contain the output </param>
+/// <returns> Number of Segments found </returns>
+int FindPlatformSegments(const struct Platform* platform, float left, float right, int* first);
 
 /// <summary>
-///	Shifts platforms array forward by one, deleting first entry and generating a new platform in last entry.
+/// Gets the boxes of the platforms that reach into an area (touching counts), for the physics to collide with.
 /// </summary>
-/// /// <param name="platforms"> Array of Platforms </param>
-/// /// <param name="drawnPlatforms"> Number of drawn Platforms </param>
-/// /// <param name="newY"> Y value of newly generated Platform </param>
-void ShiftPlatform(struct Player player, struct Platform platforms[], int drawnPlatforms, int newY, float wallWidth);
+/// <param name="world"> Address of Game World </param>
+/// <param name="left"> X value of the left of the area </param>
+/// <param name="top"> Y value of the top of the area </param>
+/// <param name="right"> X value of the right of the area </param>
+/// <param name="bottom"> Y value of the bottom of the area </param>
+/// <param name="boxes"> Array of size MAX_PLATFORMS * MAX_PLATFORM_SEGMENTS. This will contain the output </param>
+/// <returns> Number of Boxes </returns>
+int GetPlatformBoxes(const struct GameWorld* world, float left, float top, float right, float bottom, struct Physics_Box* boxes);
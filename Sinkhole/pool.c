@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------------
+// file: pool.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Entity Pools
+//		Added Pool Arrays, for entity arrays of more than POOL_CAPACITY slots
+//		Added PoolsBits, for testing slots in batches
+//
+// brief:
+// Contains functions used to spawn, despawn and go through pooled entities.
+// Every pool fits in one 64 bit mask, finding the lowest slot in use or free
+// is one bit scan instruction.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#ifdef _MSC_VER
+#include <intrin.h> // For _BitScanForward64
+#endif
+#include "initialize.h"
+#include "pool.h"
+
+// Index of the lowest set bit, bits must not be 0
+int PoolLowestBit(unsigned long long bits) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return (int)index;
+#else
+	return __builtin_ctzll(bits);
+#endif
+}
+
+int PoolSpawn(struct Entity_Pool* pool, int capacity) {
+	unsigned long long free = ~pool->live;
+	if (capacity < POOL_CAPACITY) {
+		free &= (1ULL << capacity) - 1;
+	}
+	if (!free) {
+		return -1;
+	}
+	int slot = PoolLowestBit(free);
+	pool->live |= 1ULL << slot;
+	return slot;
+}
+
+void PoolDespawn(struct Entity_Pool* pool, int slot) {
+	pool->live &= ~(1ULL << slot);
+}
+
+void PoolClear(struct Entity_Pool* pool) {
+	pool->live = 0;
+}
+
+int PoolIsLive(const struct Entity_Pool* pool, int slot) {
+	return (int)(pool->live >> slot) & 1;
+}
+
+int PoolNext(const struct Entity_Pool* pool, int slot) {
+	if (slot >= POOL_CAPACITY - 1) {
+		return -1;
+	}
+	unsigned long long after = pool->live & (~0ULL << (slot + 1)); // slot + 1 is 0 to 63
+	return after ? PoolLowestBit(after) : -1;
+}
+
+int PoolCount(const struct Entity_Pool* pool) {
+	int count = 0;
+	for (unsigned long long bits = pool->live; bits; bits &= bits - 1) { // Clears the lowest set bit
+		count++;
+	}
+	return count;
+}
+
+int PoolsSpawn(struct Entity_Pool pools[], int capacity) {
+	for (int p = 0; p * POOL_CAPACITY < capacity; ++p) {
+		int slot = PoolSpawn(&pools[p], capacity - p * POOL_CAPACITY);
+		if (slot >= 0) {
+			return p * POOL_CAPACITY + slot;
+		}
+	}
+	return -1;
+}
+
+void PoolsDespawn(struct Entity_Pool pools[], int slot) {
+	PoolDespawn(&pools[slot / POOL_CAPACITY], slot % POOL_CAPACITY);
+}
+
+int PoolsIsLive(const struct Entity_Pool pools[], int slot) {
+	return PoolIsLive(&pools[slot / POOL_CAPACITY], slot % POOL_CAPACITY);
+}
+
+unsigned int PoolsBits(const struct Entity_Pool pools[], int first, int count) {
+	// first is a multiple of 32, so the 32 slots are in the same pool
+	unsigned int bits = (unsigned int)(pools[first / POOL_CAPACITY].live >> (first % POOL_CAPACITY));
+	return count < 32 ? bits & ((1u << count) - 1) : bits;
+}
+
+int PoolsNext(const struct Entity_Pool pools[], int capacity, int slot) {
+	if (slot + 1 >= capacity) {
+		return -1;
+	}
+	int p = (slot + 1) / POOL_CAPACITY;
+	int next = PoolNext(&pools[p], (slot + 1) % POOL_CAPACITY - 1); // Rest of the pool slot is in
+	while (next < 0 && ++p * POOL_CAPACITY < capacity) { // Then the pools after it
+		next = PoolNext(&pools[p], -1);
+	}
+	return next < 0 ? -1 : p * POOL_CAPACITY + next;
+}
+
+int PoolsCount(const struct Entity_Pool pools[], int capacity) {
+	int count = 0;
+	for (int p = 0; p * POOL_CAPACITY < capacity; ++p) {
+		count += PoolCount(&pools[p]);
+	}
+	return count;
+}
@@ -0,0 +1,122 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: pool.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Entity Pools
+//		Added Pool Arrays, for entity arrays of more than POOL_CAPACITY slots
+//		Added PoolsBits, for testing slots in batches
+//
+// brief:
+// Contains the declaration of functions in pool.c.
+// Keeps track of which slots of an entity array are in use, one bit per slot,
+// so spawning finds a free slot without going through the array, and the
+// systems only go through the slots in use. Slots are handed out and gone
+// through lowest first, the same order as going through the whole array.
+//
+// Going through the slots in use:
+//	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) { ... }
+// Slots despawned or spawned after i while going through are skipped or gone
+// through, like checking every slot of the array would.
+// Bigger entity arrays keep an array of pools, slot i in pools[i / POOL_CAPACITY],
+// and use the Pools functions, which work the same way.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+/// <summary>
+/// Takes the lowest free slot.
+/// </summary>
+/// <param name="pool">Address of the Pool</param>
+/// <param name="capacity">Size of the entity array, up to POOL_CAPACITY</param>
+/// <returns>Slot taken, -1 if all are in use</returns>
+int PoolSpawn(struct Entity_Pool* pool, int capacity);
+
+/// <summary>
+/// Frees a slot. Nothing happens if it is already free.
+/// </summary>
+/// <param name="pool">Address of the Pool</param>
+/// <param name="slot">Slot to free</param>
+void PoolDespawn(struct Entity_Pool* pool, int slot);
+
+/// <summary>
+/// Frees every slot.
+/// </summary>
+/// <param name="pool">Address of the Pool</param>
+void PoolClear(struct Entity_Pool* pool);
+
+/// <summary>
+/// Checks if a slot is in use.
+/// </summary>
+/// <param name="pool">Address of the Pool</param>
+/// <param name="slot">Slot to check</param>
+/// <returns>1 if in use, else 0</returns>
+int PoolIsLive(const struct Entity_Pool* pool, int slot);
+
+/// <summary>
+/// Gets the next slot in use.
+/// </summary>
+/// <param name="pool">Address of the Pool</param>
+/// <param name="slot">Slot to look after, -1 for the first slot in use</param>
+/// <returns>Lowest slot in use after slot, -1 if there is none</returns>
+int PoolNext(const struct Entity_Pool* pool, int slot);
+
+/// <summary>
+/// Counts the slots in use.
+/// </summary>
+/// <param name="pool">Address of the Pool</param>
+/// <returns>Slots in use</returns>
+int PoolCount(const struct Entity_Pool* pool);
+
+/// <summary>
+/// Takes the lowest free slot of an array of pools.
+/// </summary>
+/// <param name="pools">Array of Pools, slot i is kept by pools[i / POOL_CAPACITY]</param>
+/// <param name="capacity">Slots that can be taken</param>
+/// <returns>Slot taken, -1 if all are in use</returns>
+int PoolsSpawn(struct Entity_Pool pools[], int capacity);
+
+/// <summary>
+/// Frees a slot of an array of pools. Nothing happens if it is already free.
+/// </summary>
+/// <param name="pools">Array of Pools</param>
+/// <param name="slot">Slot to free</param>
+void PoolsDespawn(struct Entity_Pool pools[], int slot);
+
+/// <summary>
+/// Checks if a slot of an array of pools is in use.
+/// </summary>
+/// <param name="pools">Array of Pools</param>
+/// <param name="slot">Slot to check</param>
+/// <returns>1 if in use, else 0</returns>
+int PoolsIsLive(const struct Entity_Pool pools[], int slot);
+
+/// <summary>
+/// Gets which of up to 32 slots of an array of pools are in use, to test them in one batch.
+/// </summary>
+/// <param name="pools">Array of Pools</param>
+/// <param name="first">First slot, a multiple of 32</param>
+/// <param name="count">Number of slots, up to 32</param>
+/// <returns>Bit k set if slot first + k is in use</returns>
+unsigned int PoolsBits(const struct Entity_Pool pools[], int first, int count);
+
+/// <summary>
+/// Gets the next slot in use of an array of pools.
+/// </summary>
+/// <param name="pools">Array of Pools</param>
+/// <param name="capacity">Slots that can be in use</param>
+/// <param name="slot">Slot to look after, -1 for the first slot in use</param>
+/// <returns>Lowest slot in use after slot, -1 if there is none</returns>
+int PoolsNext(const struct Entity_Pool pools[], int capacity, int slot);
+
+/// <summary>
+/// Counts the slots in use of an array of pools.
+/// </summary>
+/// <param name="pools">Array of Pools</param>
+/// <param name="capacity">Slots that can be in use</param>
+/// <returns>Slots in use</returns>
+int PoolsCount(const struct Entity_Pool pools[], int capacity);
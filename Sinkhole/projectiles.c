@@ -4,6 +4,10 @@
 // authors:
 // tituswenshuen.kwong
 //		Added bullet shooting functions
+// l.zheneudamon
+//		Changed BulletHitPlatform to look up only the platforms under the bullet
+//		Changed Bullets to be fired from and go through their Pool
+//		Changed BulletHitPlatform to test the platforms of a row in one batch
 //
 // brief:
 // Contains the function definitions that deal with the shooting logic of bullets
@@ -18,79 +22,78 @@
 //------------------------------------------------------------------------------------
 
 #include <math.h>
-#include "cprocessing.h"
 #include "initialize.h"
+#include "platforms.h"
+#include "pool.h"
 #include "utils.h"
+#include "collide.h"
 
 // Fire Bullets
-void FireBullet(struct Bullet bullets[], struct Player player, float mouseX, float mouseY) {
-	for (int i = 0; i < MAX_BULLETS; i++) {
-		if (!bullets[i].isActive) { // Find an inactive bullet to use
-			// Set the bullet's starting position to the player's (crystal) position
-			bullets[i].x = player.x;
-			bullets[i].y = player.y - (player.height + player.width) / 2.0f;
+void FireBullet(struct GameWorld* world, float mouseX, float mouseY) {
+	struct Bullet* bullets = world->bullets;
+	struct Player* player = &world->player;
+	int i = PoolSpawn(&world->bulletPool, MAX_BULLETS); // Lowest inactive bullet
+	if (i >= 0) {
+		// Set the bullet's starting position to the player's (crystal) position
+		bullets[i].x = player->x;
+		bullets[i].y = player->y - (player->height + player->width) / 2.0f;
 
-			// Calculate the direction vector from player (crystal) to mouse
-			float directionX = mouseX - bullets[i].x;
-			float directionY = mouseY - bullets[i].y;
+		// Calculate the direction vector from player (crystal) to mouse
+		float directionX = mouseX - bullets[i].x;
+		float directionY = mouseY - bullets[i].y;
 
-			// Calculate the direction's magnitude and normalize it (make it a unit vector)
-			float directionMagnitude = sqrtf(directionX * directionX + directionY * directionY);
-			float normalizedDirectionX = directionX / directionMagnitude;
-			float normalizedDirectionY = directionY / directionMagnitude;
+		// Calculate the direction's magnitude and normalize it (make it a unit vector)
+		float directionMagnitude = sqrtf(directionX * directionX + directionY * directionY);
+		float normalizedDirectionX = directionX / directionMagnitude;
+		float normalizedDirectionY = directionY / directionMagnitude;
 
-			bullets[i].diameterSize = (float)player.projectileSize; // Set the bullet's size
-			bullets[i].velocity = (float)player.projectileSpeed; // Set the bullet's speed
-			bullets[i].directionX = normalizedDirectionX; // Store the X component of the normalized direction
-			bullets[i].directionY = normalizedDirectionY; // Store the Y component of the normalized direction
-			bullets[i].isActive = 1;
-			bullets[i].distanceTraveled = 0.0; // Reset the distance traveled by the bullet
-
-			break;
-		}
+		bullets[i].diameterSize = (float)player->projectileSize; // Set the bullet's size
+		bullets[i].velocity = (float)player->projectileSpeed; // Set the bullet's speed
+		bullets[i].directionX = normalizedDirectionX; // Store the X component of the normalized direction
+		bullets[i].directionY = normalizedDirectionY; // Store the Y component of the normalized direction
+		bullets[i].distanceTraveled = 0.0; // Reset the distance traveled by the bullet
 	}
 }
 
 // Update Bullets
-void UpdateBullets(struct Bullet bullets[], float maxY, float wallWidth) {
-	float deltaTime = CP_System_GetDt();
-	for (int i = 0; i < MAX_BULLETS; i++) {
-		if (bullets[i].isActive) { // Check if the bullet is active
-			// Update the bullet's position using both X and Y components of the normalized direction vector
-			bullets[i].x += bullets[i].velocity * deltaTime * bullets[i].directionX;
-			bullets[i].y += bullets[i].velocity * deltaTime * bullets[i].directionY;
-			bullets[i].distanceTraveled += bullets[i].velocity * deltaTime;
+void UpdateBullets(struct GameWorld* world, float deltaTime) {
+	struct Entity_Pool* pool = &world->bulletPool;
+	struct Bullet* bullets = world->bullets;
+	float maxY = world->maxY;
+	float wallWidth = world->wallWidth;
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) { // Active bullets
+		// Update the bullet's position using both X and Y components of the normalized direction vector
+		bullets[i].x += bullets[i].velocity * deltaTime * bullets[i].directionX;
+		bullets[i].y += bullets[i].velocity * deltaTime * bullets[i].directionY;
+		bullets[i].distanceTraveled += bullets[i].velocity * deltaTime;
 
-			// Check for collision with left wall, right wall, screen top, and screen bottom
-			// If hit boundaries, set to not active
-			if (bullets[i].x < wallWidth) {
-				bullets[i].isActive = 0;
-			} else if (bullets[i].x > (CP_System_GetWindowWidth() - wallWidth)) {
-				bullets[i].isActive = 0;
-			} else if (bullets[i].y < maxY - CP_System_GetWindowHeight() / 2.0) {
-				bullets[i].isActive = 0;
-			} else if (bullets[i].y > maxY + CP_System_GetWindowHeight() / 2.0) {
-				bullets[i].isActive = 0;
-			}
+		// Check for collision with left wall, right wall, screen top, and screen bottom
+		// If hit boundaries, set to not active
+		if (bullets[i].x < wallWidth) {
+			PoolDespawn(pool, i);
+		} else if (bullets[i].x > (WINDOW_WIDTH - wallWidth)) {
+			PoolDespawn(pool, i);
+		} else if (bullets[i].y < maxY - WINDOW_HEIGHT / 2.0) {
+			PoolDespawn(pool, i);
+		} else if (bullets[i].y > maxY + WINDOW_HEIGHT / 2.0) {
+			PoolDespawn(pool, i);
 		}
 	}
 }
 
 // Update Bullet Conditions
-void BulletHitPlatform(struct Bullet bullets[], struct Platform platforms[], float platformHeight) {
-	for (int i = 0; i < MAX_BULLETS; i++) {
-		if (bullets[i].isActive) {
-			for (int j = 0; j < MAX_PLATFORMS; j++) {
-				float platform1x = platforms[j].p1Coord, platform1y = ((platforms[j].y) * 100.0f), platform1Width = (float)platforms[j].p1Length, platform1Height = platformHeight;
-				float platform2x = platforms[j].p2Coord, platform2y = ((platforms[j].y) * 100.0f), platform2Width = (float)platforms[j].p2Length, platform2Height = platformHeight;
-				if (IsCircleAndRectIntersecting(bullets[i].x, bullets[i].y, bullets[i].diameterSize, platform1x, platform1y, platform1Width, platform1Height)) { // Platform 1
-					bullets[i].isActive = 0;
-					break;
-				} else if (IsCircleAndRectIntersecting(bullets[i].x, bullets[i].y, bullets[i].diameterSize, platform2x, platform2y, platform2Width, platform2Height)) { // Platform 2
-					bullets[i].isActive = 0;
-					break;
-				}
+void BulletHitPlatform(struct GameWorld* world) {
+	struct Entity_Pool* pool = &world->bulletPool;
+	struct Bullet* bullets = world->bullets;
+	for (int i = PoolNext(pool, -1); i >= 0; i = PoolNext(pool, i)) {
+		float radius = bullets[i].diameterSize / 2.0f;
+		for (int j = 0; j < world->platformCount && PoolIsLive(pool, i); j++) {
+			const struct Platform* platform = GetPlatformRow(world, j);
+			int first;
+			int segmentCount = FindPlatformSegments(platform, bullets[i].x - radius, bullets[i].x + radius, &first); // Only the platforms under the bullet
+			if (segmentCount > 0 && CircleHitsSegments(bullets[i].x, bullets[i].y, bullets[i].diameterSize, &platform->left[first], &platform->right[first], platform->top, platform->bottom, segmentCount)) {
+				PoolDespawn(pool, i);
 			}
 		}
 	}
-}
+}
\ No newline at end of file
@@ -21,24 +21,20 @@
 /// <summary>
 /// Attempts to fire a bullet. Do this on left clicks.
 /// </summary>
-/// <param name="bullets">Array of Bullets</param>
-/// <param name="player">Player</param>
+/// <param name="world">Address of Game World</param>
 /// <param name="mouseX">Mouse World X Value</param>
 /// <param name="mouseY">Mouse World Y Value</param>
-void FireBullet(struct Bullet bullets[], struct Player player, float mouseX, float mouseY);
+void FireBullet(struct GameWorld* world, float mouseX, float mouseY);
 
 /// <summary>
 /// Moves and Checks if bullets hit anything
 /// </summary>
-/// <param name="bullets">Array of Bullets</param>
-/// <param name="maxY">Midpoint of Screen Y</param>
-/// <param name="wallWidth">Width of Side Walls</param>
-void UpdateBullets(struct Bullet bullets[], float maxY, float wallWidth);
+/// <param name="world">Address of Game World</param>
+/// <param name="deltaTime">Time Step in Seconds</param>
+void UpdateBullets(struct GameWorld* world, float deltaTime);
 
 /// <summary>
 /// Handles the logic of a bullet hitting a platform.
 /// </summary>
-/// <param name="bullets">Array of Bullets</param>
-/// <param name="platforms">Array of Platforms</param>
-/// <param name="platformHeight">Platform Height</param>
-void BulletHitPlatform(struct Bullet bullets[], struct Platform platforms[], float platformHeight);
+/// <param name="world">Address of Game World</param>
+void BulletHitPlatform(struct GameWorld* world);
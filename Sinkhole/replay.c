@@ -0,0 +1,512 @@
+//------------------------------------------------------------------------------------
+// file: replay.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Input Recording and Replay Playback
+//		Added Keyframes for Seeking
+//		Added World Hashes for Determinism Checks
+//		Added World Layout Tag, replays of another layout are not loaded
+//
+// brief:
+// Records the input of every step and plays it back.
+// Each record only holds what changed since the record before it, and
+// runs of steps with the same input share one record. Numbers are written
+// as varints (7 bits per byte), mouse positions as the zigzagged difference
+// of their float bits, so they come back exactly as they were recorded.
+// Keyframes are raw copies of the world (it holds no pointers) with long
+// runs of zero bytes left out, as most of it is empty enemy/bullet slots.
+//
+// File Layout:
+// "SKRP", version, WORLD_LAYOUT_VERSION, size of a snapshot,
+// seed, steps, size of records, records,
+// keyframe count, size of keyframes, keyframes,
+// hashes per step, size of hashes, hashes
+//
+// Keyframe Layout:
+// position in records, size of snapshot, snapshot
+// Snapshot: (zero bytes left out, bytes kept, kept bytes) until the end of the world
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "initialize.h"
+#include "sim.h"
+#include "hash.h"
+#include "replay.h"
+
+#pragma region encoding
+
+// Everything a keyframe restores
+struct Replay_Snapshot {
+	struct GameWorld world;
+	struct Sim_Input input; // Last input read, the next record is a delta of it
+};
+
+FILE* Replay_OpenFile(const char* path, const char* mode) {
+	FILE* file = NULL;
+#ifdef _MSC_VER
+	if (fopen_s(&file, path, mode) != 0) {
+		file = NULL;
+	}
+#else
+	file = fopen(path, mode);
+#endif
+	return file;
+}
+
+// Returns 1 if the buffer has space for that many more bytes
+int Replay_Reserve(struct Replay_Buffer* buffer, int bytes) {
+	if (buffer->size + bytes <= buffer->capacity) {
+		return 1;
+	}
+	int capacity = buffer->capacity > 0 ? buffer->capacity * 2 : 4096;
+	while (capacity < buffer->size + bytes) {
+		capacity *= 2;
+	}
+	unsigned char* data = realloc(buffer->data, capacity);
+	if (data == NULL) { // Out of memory, the replay stops growing
+		return 0;
+	}
+	buffer->data = data;
+	buffer->capacity = capacity;
+	return 1;
+}
+
+void Replay_WriteVarint(struct Replay_Buffer* buffer, unsigned long long value) {
+	if (!Replay_Reserve(buffer, 10)) {
+		return;
+	}
+	while (value >= 0x80) {
+		buffer->data[buffer->size++] = (unsigned char)(value | 0x80);
+		value >>= 7;
+	}
+	buffer->data[buffer->size++] = (unsigned char)value;
+}
+
+void Replay_WriteBytes(struct Replay_Buffer* buffer, const unsigned char* bytes, int count) {
+	if (Replay_Reserve(buffer, count)) {
+		memcpy(buffer->data + buffer->size, bytes, count);
+		buffer->size += count;
+	}
+}
+
+unsigned long long Replay_ReadVarint(const unsigned char* data, int size, int* position) {
+	unsigned long long value = 0;
+	for (int shift = 0; *position < size && shift < 64; shift += 7) {
+		unsigned char byte = data[(*position)++];
+		value |= (unsigned long long)(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			break;
+		}
+	}
+	return value;
+}
+
+unsigned int FloatBits(float value) {
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+float BitsFloat(unsigned int bits) {
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+// Small differences (both ways) become small numbers: 0, -1, 1, -2, 2 -> 0, 1, 2, 3, 4
+unsigned int ZigZag(unsigned int difference) {
+	return (difference << 1) ^ (unsigned int)-(int)(difference >> 31);
+}
+
+unsigned int UnZigZag(unsigned int value) {
+	return (value >> 1) ^ (unsigned int)-(int)(value & 1);
+}
+
+int PackInputFlags(const struct Sim_Input* input) {
+	return (input->wKeyPressed ? REPLAY_INPUT_W_PRESSED : 0)
+		| (input->wKeyTriggered ? REPLAY_INPUT_W_TRIGGERED : 0)
+		| (input->aKeyPressed ? REPLAY_INPUT_A_PRESSED : 0)
+		| (input->sKeyPressed ? REPLAY_INPUT_S_PRESSED : 0)
+		| (input->dKeyPressed ? REPLAY_INPUT_D_PRESSED : 0)
+		| (input->escKeyPressed ? REPLAY_INPUT_ESC_PRESSED : 0)
+		| (input->leftMouseClick ? REPLAY_INPUT_MOUSE_CLICK : 0)
+		| (input->leftMouseHold ? REPLAY_INPUT_MOUSE_HOLD : 0)
+		| (input->resumeClicked ? REPLAY_INPUT_RESUME_CLICKED : 0);
+}
+
+void UnpackInputFlags(struct Sim_Input* input, int flags) {
+	input->wKeyPressed = (flags & REPLAY_INPUT_W_PRESSED) != 0;
+	input->wKeyTriggered = (flags & REPLAY_INPUT_W_TRIGGERED) != 0;
+	input->aKeyPressed = (flags & REPLAY_INPUT_A_PRESSED) != 0;
+	input->sKeyPressed = (flags & REPLAY_INPUT_S_PRESSED) != 0;
+	input->dKeyPressed = (flags & REPLAY_INPUT_D_PRESSED) != 0;
+	input->escKeyPressed = (flags & REPLAY_INPUT_ESC_PRESSED) != 0;
+	input->leftMouseClick = (flags & REPLAY_INPUT_MOUSE_CLICK) != 0;
+	input->leftMouseHold = (flags & REPLAY_INPUT_MOUSE_HOLD) != 0;
+	input->resumeClicked = (flags & REPLAY_INPUT_RESUME_CLICKED) != 0;
+}
+
+void Replay_WriteSnapshot(struct Replay_Buffer* buffer, const unsigned char* bytes, int size) {
+	int i = 0;
+	while (i < size) {
+		int zeros = 0;
+		while (i + zeros < size && bytes[i + zeros] == 0) {
+			zeros++;
+		}
+		i += zeros;
+
+		// Keep bytes up to the next run of zeros worth leaving out
+		int kept = 0, zeroRun = 0;
+		while (i + kept < size && zeroRun < REPLAY_MIN_ZERO_RUN) {
+			zeroRun = bytes[i + kept] == 0 ? zeroRun + 1 : 0;
+			kept++;
+		}
+		if (zeroRun == REPLAY_MIN_ZERO_RUN) {
+			kept -= zeroRun;
+		}
+
+		Replay_WriteVarint(buffer, zeros);
+		Replay_WriteVarint(buffer, kept);
+		Replay_WriteBytes(buffer, bytes + i, kept);
+		i += kept;
+	}
+}
+
+// Returns 1 if the snapshot filled exactly size bytes
+int Replay_ReadSnapshot(const unsigned char* data, int dataSize, unsigned char* bytes, int size) {
+	int position = 0, i = 0;
+	while (position < dataSize && i < size) {
+		int zeros = (int)Replay_ReadVarint(data, dataSize, &position);
+		if (zeros > size - i) {
+			return 0;
+		}
+		memset(bytes + i, 0, zeros);
+		i += zeros;
+
+		int kept = (int)Replay_ReadVarint(data, dataSize, &position);
+		if (kept > size - i || kept > dataSize - position) {
+			return 0;
+		}
+		memcpy(bytes + i, data + position, kept);
+		position += kept;
+		i += kept;
+	}
+	return i == size;
+}
+
+#pragma endregion
+
+#pragma region recording
+
+void Replay_StartRecording(struct Replay* replay, unsigned long long seed) {
+	Replay_Free(replay);
+	replay->seed = seed;
+}
+
+// Writes the pending input as one record
+void Replay_Flush(struct Replay* replay) {
+	if (!replay->hasPending) {
+		return;
+	}
+
+	int flags = PackInputFlags(&replay->pending);
+	unsigned int mouseX = FloatBits(replay->pending.mouseX), lastMouseX = FloatBits(replay->last.mouseX);
+	unsigned int mouseY = FloatBits(replay->pending.mouseY), lastMouseY = FloatBits(replay->last.mouseY);
+	int changed = (flags != PackInputFlags(&replay->last) ? REPLAY_CHANGED_FLAGS : 0)
+		| (mouseX != lastMouseX ? REPLAY_CHANGED_MOUSE_X : 0)
+		| (mouseY != lastMouseY ? REPLAY_CHANGED_MOUSE_Y : 0);
+
+	Replay_WriteVarint(&replay->records, ((unsigned long long)replay->pendingRepeats << REPLAY_CHANGED_BITS) | changed);
+	if (changed & REPLAY_CHANGED_FLAGS) {
+		Replay_WriteVarint(&replay->records, flags);
+	}
+	if (changed & REPLAY_CHANGED_MOUSE_X) {
+		Replay_WriteVarint(&replay->records, ZigZag(mouseX - lastMouseX));
+	}
+	if (changed & REPLAY_CHANGED_MOUSE_Y) {
+		Replay_WriteVarint(&replay->records, ZigZag(mouseY - lastMouseY));
+	}
+
+	replay->last = replay->pending;
+	replay->hasPending = 0;
+	replay->pendingRepeats = 0;
+}
+
+void Replay_RecordKeyframe(struct Replay* replay, const struct GameWorld* world) {
+	Replay_Flush(replay); // The next step starts a new record, so playback can start from it
+
+	struct Replay_Snapshot snapshot;
+	memcpy(&snapshot.world, world, sizeof(snapshot.world));
+	snapshot.input = replay->last;
+
+	struct Replay_Buffer encoded = { 0 };
+	Replay_WriteSnapshot(&encoded, (const unsigned char*)&snapshot, sizeof(snapshot));
+	Replay_WriteVarint(&replay->keyframes, replay->records.size);
+	Replay_WriteVarint(&replay->keyframes, encoded.size);
+	Replay_WriteBytes(&replay->keyframes, encoded.data, encoded.size);
+	free(encoded.data);
+	replay->keyframeCount++;
+}
+
+void Replay_RecordStep(struct Replay* replay, const struct GameWorld* world, const struct Sim_Input* input) {
+	if (replay->steps % REPLAY_KEYFRAME_STEPS == 0) {
+		Replay_RecordKeyframe(replay, world);
+	}
+
+	if (replay->hasPending && memcmp(&replay->pending, input, sizeof(*input)) == 0) {
+		replay->pendingRepeats++;
+	} else {
+		Replay_Flush(replay);
+		replay->pending = *input;
+		replay->hasPending = 1;
+	}
+	replay->steps++;
+}
+
+void Replay_RecordHash(struct Replay* replay, const struct GameWorld* world) {
+	unsigned int hashes[MAX_WORLD_HASHES];
+	HashWorld(world, hashes);
+	if (Replay_Reserve(&replay->hashes, MAX_WORLD_HASHES * REPLAY_HASH_BYTES)) {
+		for (int i = 0; i < MAX_WORLD_HASHES; ++i) {
+			for (int b = 0; b < REPLAY_HASH_BYTES; ++b) {
+				replay->hashes.data[replay->hashes.size++] = (unsigned char)(hashes[i] >> (8 * b));
+			}
+		}
+	}
+}
+
+int Replay_Save(struct Replay* replay, const char* path) {
+	Replay_Flush(replay);
+
+	struct Replay_Buffer header = { 0 };
+	Replay_WriteBytes(&header, (const unsigned char*)"SKRP", 4);
+	Replay_WriteVarint(&header, REPLAY_VERSION);
+	Replay_WriteVarint(&header, WORLD_LAYOUT_VERSION);
+	Replay_WriteVarint(&header, sizeof(struct Replay_Snapshot));
+	Replay_WriteVarint(&header, replay->seed);
+	Replay_WriteVarint(&header, replay->steps);
+	Replay_WriteVarint(&header, replay->records.size);
+
+	struct Replay_Buffer keyframeHeader = { 0 };
+	Replay_WriteVarint(&keyframeHeader, replay->keyframeCount);
+	Replay_WriteVarint(&keyframeHeader, replay->keyframes.size);
+	struct Replay_Buffer hashHeader = { 0 };
+	Replay_WriteVarint(&hashHeader, MAX_WORLD_HASHES);
+	Replay_WriteVarint(&hashHeader, replay->hashes.size);
+
+	FILE* file = Replay_OpenFile(path, "wb");
+	int isWritten = 0;
+	if (file != NULL && header.data != NULL && keyframeHeader.data != NULL && hashHeader.data != NULL) {
+		isWritten = fwrite(header.data, 1, header.size, file) == (size_t)header.size
+			&& fwrite(replay->records.data, 1, replay->records.size, file) == (size_t)replay->records.size
+			&& fwrite(keyframeHeader.data, 1, keyframeHeader.size, file) == (size_t)keyframeHeader.size
+			&& fwrite(replay->keyframes.data, 1, replay->keyframes.size, file) == (size_t)replay->keyframes.size
+			&& fwrite(hashHeader.data, 1, hashHeader.size, file) == (size_t)hashHeader.size
+			&& fwrite(replay->hashes.data, 1, replay->hashes.size, file) == (size_t)replay->hashes.size;
+	}
+	if (file != NULL) {
+		isWritten = fclose(file) == 0 && isWritten;
+	}
+	free(header.data);
+	free(keyframeHeader.data);
+	free(hashHeader.data);
+	return isWritten;
+}
+
+#pragma endregion
+
+#pragma region playback
+
+// Reads a varint straight from a file, returns 0 if the file ended
+int Replay_ReadFileVarint(FILE* file, unsigned long long* value) {
+	*value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		int byte = fgetc(file);
+		if (byte == EOF) {
+			return 0;
+		}
+		*value |= (unsigned long long)(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Reads size bytes from a file into an empty buffer
+int Replay_ReadFileBuffer(FILE* file, struct Replay_Buffer* buffer, unsigned long long size) {
+	if (size > 0x7FFFFFFF || !Replay_Reserve(buffer, (int)size)) {
+		return 0;
+	}
+	buffer->size = (int)size;
+	return fread(buffer->data, 1, buffer->size, file) == (size_t)buffer->size;
+}
+
+int Replay_Load(struct Replay* replay, const char* path) {
+	Replay_Free(replay);
+
+	FILE* file = Replay_OpenFile(path, "rb");
+	if (file == NULL) {
+		return 0;
+	}
+
+	char magic[4];
+	unsigned long long version = 0, layout = 0, snapshotSize = 0, steps = 0, size = 0, keyframeCount = 0, hashesPerStep = 0;
+	// Older versions and other world layouts are not loaded, their keyframes would restore into the wrong fields
+	// and their platforms would not play out the same
+	int isValid = fread(magic, 1, 4, file) == 4 && memcmp(magic, "SKRP", 4) == 0
+		&& Replay_ReadFileVarint(file, &version) && version == REPLAY_VERSION
+		&& Replay_ReadFileVarint(file, &layout) && layout == WORLD_LAYOUT_VERSION
+		&& Replay_ReadFileVarint(file, &snapshotSize) && snapshotSize == sizeof(struct Replay_Snapshot)
+		&& Replay_ReadFileVarint(file, &replay->seed)
+		&& Replay_ReadFileVarint(file, &steps)
+		&& Replay_ReadFileVarint(file, &size)
+		&& Replay_ReadFileBuffer(file, &replay->records, size)
+		&& Replay_ReadFileVarint(file, &keyframeCount)
+		&& Replay_ReadFileVarint(file, &size)
+		&& Replay_ReadFileBuffer(file, &replay->keyframes, size)
+		&& Replay_ReadFileVarint(file, &hashesPerStep)
+		&& Replay_ReadFileVarint(file, &size)
+		&& Replay_ReadFileBuffer(file, &replay->hashes, size);
+	fclose(file);
+
+	if (isValid && hashesPerStep != MAX_WORLD_HASHES) { // Hashed by a different version of the game, can't be compared
+		replay->hashes.size = 0;
+	}
+
+	if (!isValid) {
+		Replay_Free(replay);
+		return 0;
+	}
+	replay->steps = (long)steps;
+	replay->keyframeCount = (int)keyframeCount;
+	replay->isPlaying = 1;
+	return 1;
+}
+
+int Replay_ReadStep(struct Replay* replay, struct Sim_Input* input) {
+	if (!replay->isPlaying || replay->stepsRead >= replay->steps) {
+		return 0;
+	}
+
+	if (replay->repeatsLeft > 0) { // Same input as the step before
+		replay->repeatsLeft--;
+	} else {
+		const unsigned char* data = replay->records.data;
+		int size = replay->records.size;
+		if (replay->readPosition >= size) {
+			return 0;
+		}
+		unsigned long long header = Replay_ReadVarint(data, size, &replay->readPosition);
+		int changed = (int)(header & ((1 << REPLAY_CHANGED_BITS) - 1));
+		replay->repeatsLeft = (int)(header >> REPLAY_CHANGED_BITS);
+
+		if (changed & REPLAY_CHANGED_FLAGS) {
+			UnpackInputFlags(&replay->last, (int)Replay_ReadVarint(data, size, &replay->readPosition));
+		}
+		if (changed & REPLAY_CHANGED_MOUSE_X) {
+			unsigned int difference = UnZigZag((unsigned int)Replay_ReadVarint(data, size, &replay->readPosition));
+			replay->last.mouseX = BitsFloat(FloatBits(replay->last.mouseX) + difference);
+		}
+		if (changed & REPLAY_CHANGED_MOUSE_Y) {
+			unsigned int difference = UnZigZag((unsigned int)Replay_ReadVarint(data, size, &replay->readPosition));
+			replay->last.mouseY = BitsFloat(FloatBits(replay->last.mouseY) + difference);
+		}
+	}
+
+	*input = replay->last;
+	replay->stepsRead++;
+	return 1;
+}
+
+// Restores keyframe number index, returns 1 if it was found and is valid
+int Replay_RestoreKeyframe(struct Replay* replay, struct GameWorld* world, int index) {
+	const unsigned char* data = replay->keyframes.data;
+	int size = replay->keyframes.size;
+	int position = 0;
+	for (int i = 0; i < replay->keyframeCount && position < size; ++i) {
+		int recordPosition = (int)Replay_ReadVarint(data, size, &position);
+		int snapshotSize = (int)Replay_ReadVarint(data, size, &position);
+		if (snapshotSize < 0 || snapshotSize > size - position) {
+			return 0;
+		}
+		if (i == index) {
+			struct Replay_Snapshot snapshot;
+			if (!Replay_ReadSnapshot(data + position, snapshotSize, (unsigned char*)&snapshot, sizeof(snapshot))) {
+				return 0;
+			}
+			memcpy(world, &snapshot.world, sizeof(*world));
+			replay->last = snapshot.input;
+			replay->readPosition = recordPosition;
+			replay->repeatsLeft = 0;
+			replay->stepsRead = (long)index * REPLAY_KEYFRAME_STEPS;
+			return 1;
+		}
+		position += snapshotSize;
+	}
+	return 0;
+}
+
+int Replay_CheckHash(const struct Replay* replay, long step, const struct GameWorld* world) {
+	int stepBytes = MAX_WORLD_HASHES * REPLAY_HASH_BYTES;
+	if (step < 0 || (step + 1) * stepBytes > replay->hashes.size) {
+		return -1;
+	}
+
+	unsigned int hashes[MAX_WORLD_HASHES];
+	HashWorld(world, hashes);
+	const unsigned char* recorded = replay->hashes.data + step * stepBytes;
+	int differs = 0;
+	for (int i = 0; i < MAX_WORLD_HASHES; ++i) {
+		for (int b = 0; b < REPLAY_HASH_BYTES; ++b) {
+			if (recorded[i * REPLAY_HASH_BYTES + b] != (unsigned char)(hashes[i] >> (8 * b))) {
+				differs |= 1 << i;
+			}
+		}
+	}
+	return differs;
+}
+
+long Replay_Seek(struct Replay* replay, struct GameWorld* world, long step) {
+	step = step < 0 ? 0 : step > replay->steps ? replay->steps : step;
+
+	// Going forwards within the same keyframe, carrying on is quicker than restoring
+	long keyframe = step / REPLAY_KEYFRAME_STEPS;
+	int isAhead = step >= replay->stepsRead && replay->stepsRead / REPLAY_KEYFRAME_STEPS == keyframe;
+	if (!isAhead) {
+		if (keyframe >= replay->keyframeCount) {
+			keyframe = replay->keyframeCount - 1;
+		}
+		if (keyframe < 0 || !Replay_RestoreKeyframe(replay, world, (int)keyframe)) { // Play out from the start
+			Sim_Init(world, replay->seed);
+			memset(&replay->last, 0, sizeof(replay->last));
+			replay->readPosition = 0;
+			replay->repeatsLeft = 0;
+			replay->stepsRead = 0;
+		}
+	}
+
+	float dt = 1.0f / SIM_STEPS_PER_SECOND;
+	struct Sim_Input input;
+	while (replay->stepsRead < step && Replay_ReadStep(replay, &input)) {
+		Sim_Step(world, &input, dt);
+	}
+	return replay->stepsRead;
+}
+
+#pragma endregion
+
+void Replay_Free(struct Replay* replay) {
+	free(replay->records.data);
+	free(replay->keyframes.data);
+	free(replay->hashes.data);
+	memset(replay, 0, sizeof(*replay));
+}
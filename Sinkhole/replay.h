@@ -0,0 +1,154 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: replay.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Input Recording and Replay Playback
+//		Added Keyframes for Seeking
+//		Added World Hashes for Determinism Checks
+//		Added World Layout Tag, replays of another layout are not loaded
+//
+// brief:
+// Contains the declaration of functions in replay.c.
+// A replay is the seed of a run plus the input of every step, which is
+// all the simulation needs to play the run out again exactly.
+// Every few seconds a keyframe (a snapshot of the whole world) is stored
+// as well, so seeking only has to play out the steps after the closest one.
+// The world is also hashed after every step (see hash.h), so playing the
+// replay back on changed code shows the first step where gameplay changed.
+// Keyframes are raw copies of the world, so the file also stores
+// WORLD_LAYOUT_VERSION and the size of a keyframe, and a game with a
+// different world layout does not load it.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+enum {
+	// Replay File
+	REPLAY_VERSION = 4, // Older files have no world layout tag and are not loaded
+	REPLAY_KEYFRAME_STEPS = 600, // A keyframe every 10 seconds of simulation
+	REPLAY_MIN_ZERO_RUN = 4, // Keyframes leave out runs of zero bytes at least this long
+	REPLAY_HASH_BYTES = 2, // Bytes kept of each world hash, a miss is 1 in 65536 per part and step
+
+	// Input Flags (Packed into one number per record)
+	REPLAY_INPUT_W_PRESSED = 1,
+	REPLAY_INPUT_W_TRIGGERED = 2,
+	REPLAY_INPUT_A_PRESSED = 4,
+	REPLAY_INPUT_S_PRESSED = 8,
+	REPLAY_INPUT_D_PRESSED = 16,
+	REPLAY_INPUT_ESC_PRESSED = 32,
+	REPLAY_INPUT_MOUSE_CLICK = 64,
+	REPLAY_INPUT_MOUSE_HOLD = 128,
+	REPLAY_INPUT_RESUME_CLICKED = 256,
+
+	// Record Header (Which fields changed since the last record)
+	REPLAY_CHANGED_FLAGS = 1,
+	REPLAY_CHANGED_MOUSE_X = 2,
+	REPLAY_CHANGED_MOUSE_Y = 4,
+	REPLAY_CHANGED_BITS = 3, // The rest of the header is how many more steps repeat the record
+};
+
+struct Replay_Buffer {
+	unsigned char* data;
+	int size;
+	int capacity;
+};
+
+struct Replay {
+	struct Replay_Buffer records; // Encoded input of every step
+	struct Replay_Buffer keyframes; // Encoded world snapshots, one every REPLAY_KEYFRAME_STEPS steps
+	int keyframeCount;
+	struct Replay_Buffer hashes; // World hashes after every step, MAX_WORLD_HASHES of REPLAY_HASH_BYTES each
+	unsigned long long seed;
+	long steps; // Steps recorded, or steps in the file when playing
+
+	// Recording
+	struct Sim_Input pending; // Input not written yet
+	int pendingRepeats; // Steps after the first that had the same input as pending
+	int hasPending;
+
+	// Playback
+	int isPlaying;
+	int readPosition;
+	long stepsRead;
+	int repeatsLeft;
+
+	struct Sim_Input last; // Last input written or read, records are deltas of it
+};
+
+/// <summary>
+/// Clears the replay and starts recording a new run.
+/// </summary>
+/// <param name="replay">Address of Replay</param>
+/// <param name="seed">Seed the run was started with</param>
+void Replay_StartRecording(struct Replay* replay, unsigned long long seed);
+
+/// <summary>
+/// Adds the input of one step, and a keyframe of the world every REPLAY_KEYFRAME_STEPS steps.
+/// Call right before Sim_Step, with the exact input passed to it.
+/// </summary>
+/// <param name="replay">Address of Replay</param>
+/// <param name="world">Address of Game World, as it is before the step</param>
+/// <param name="input">Input of the step</param>
+void Replay_RecordStep(struct Replay* replay, const struct GameWorld* world, const struct Sim_Input* input);
+
+/// <summary>
+/// Adds the hashes of the world after a step. Call right after Sim_Step.
+/// </summary>
+/// <param name="replay">Address of Replay</param>
+/// <param name="world">Address of Game World, as it is after the step</param>
+void Replay_RecordHash(struct Replay* replay, const struct GameWorld* world);
+
+/// <summary>
+/// Writes the recorded run to a file.
+/// </summary>
+/// <param name="replay">Address of Replay</param>
+/// <param name="path">File to write to</param>
+/// <returns>1 if the file was written, else 0</returns>
+int Replay_Save(struct Replay* replay, const char* path);
+
+/// <summary>
+/// Reads a replay file and starts playing it from the first step.
+/// </summary>
+/// <param name="replay">Address of Replay</param>
+/// <param name="path">File to read from</param>
+/// <returns>1 if the file was read, 0 if it could not be or was recorded with another version or world layout</returns>
+int Replay_Load(struct Replay* replay, const char* path);
+
+/// <summary>
+/// Reads the input of the next step.
+/// </summary>
+/// <param name="replay">Address of Replay</param>
+/// <param name="input">Address of Input to fill in</param>
+/// <returns>1 if there was a step left, 0 once the replay has ended</returns>
+int Replay_ReadStep(struct Replay* replay, struct Sim_Input* input);
+
+/// <summary>
+/// Compares the world after a step with the hashes recorded for that step.
+/// </summary>
+/// <param name="replay">Address of Replay</param>
+/// <param name="step">Step the world was just stepped with (stepsRead - 1)</param>
+/// <param name="world">Address of Game World, as it is after the step</param>
+/// <returns>Bits (1 &lt;&lt; WORLD_HASH_*) of the parts that differ, 0 if none, -1 if no hashes were recorded</returns>
+int Replay_CheckHash(const struct Replay* replay, long step, const struct GameWorld* world);
+
+/// <summary>
+/// Jumps to a step of the replay. Restores the closest keyframe at or before
+/// the step and plays out the rest, so the world is exactly as it was
+/// right before that step. Seeking past the end stops at the end.
+/// </summary>
+/// <param name="replay">Address of Replay, must be playing</param>
+/// <param name="world">Address of Game World to restore</param>
+/// <param name="step">Step to seek to</param>
+/// <returns>The step seeked to</returns>
+long Replay_Seek(struct Replay* replay, struct GameWorld* world, long step);
+
+/// <summary>
+/// Frees the memory used by the replay.
+/// </summary>
+/// <param name="replay">Address of Replay</param>
+void Replay_Free(struct Replay* replay);
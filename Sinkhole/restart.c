@@ -14,13 +14,11 @@
 // All Content  2023 DigiPen Institute of Technology Singapore, All rights reserved.
 //------------------------------------------------------------------------------------
 
-#include <time.h>
-#include <stdlib.h> 
 #include "cprocessing.h"
 #include "game.h"
 
 void Restart_Init(void) {
-	srand((unsigned int)time(NULL));
+
 }
 
 void Restart_Update(void) {
@@ -0,0 +1,437 @@
+//------------------------------------------------------------------------------------
+// file: sim.c
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Moved the game logic out of Game_Update into Sim_Step
+//		Player animation and sound effects are raised as flags for game.c
+//
+// brief:
+// Contains the simulation of the game. Everything that changes the
+// state of the game lives here, drawing and sounds are left to game.c.
+// Does not include CProcessing so it can also be stepped by headless.c.
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+#include <math.h>
+#include <string.h>
+#include "initialize.h"
+#include "utils.h"
+#include "pickups.h"
+#include "physics.h"
+#include "pool.h"
+#include "platforms.h"
+#include "upgrades.h"
+#include "projectiles.h"
+#include "enemy.h"
+#include "hazards.h"
+#include "difficulty.h"
+#include "replay.h"
+#include "sim.h"
+
+void Sim_Init(struct GameWorld* world, unsigned long long seed) {
+	memset(world, 0, sizeof(*world));
+
+	world->seed = seed;
+	for (int i = 0; i < MAX_RNG_STREAMS; ++i) {
+		SeedRandom(&world->rng[i], seed, i);
+	}
+
+	world->gameState = GAME_STATE_PLAYING;
+	world->scoreMultipler = 1.0f;
+
+	InitializePlayer(&world->player);
+	InitializeBullets(world->bullets, &world->bulletPool);
+	InitializePickups(world->pickups, &world->pickupPool);
+	InitializeLazerHazard(world->lazerHazards, &world->lazerHazardPool);
+	InitializeFlyingEnemies(world->flyingEnemies, &world->flyingEnemyPool);
+	InitializeWalkingEnemies(&world->walkingEnemies);
+	world->walkingEnemyCap = MAX_WALKING_ENEMIES;
+	InitializeDifficulty(&world->difficulty);
+
+	#pragma region platforms
+
+	world->wallWidth = (WINDOW_WIDTH / 5.0f);				// The width of the side walls
+	world->lastPlayerHeightThreshold = 9;					// The Y value the player has to pass to start generating non-starting platforms
+	world->distanceBetweenPlatform = 2;						// Y distance between platforms (2 * 100 = 200)
+	world->platformHeight = WINDOW_HEIGHT / 100.0f;			// Actual height of the platform
+
+	// Generates the starting platforms of the game
+	world->platformHead = 0;
+	world->platformCount = PLATFORM_WINDOW_ROWS;
+	for (int i = 0; i < PLATFORM_WINDOW_ROWS; ++i) {
+		world->platforms[i].y = (i * 200 + 500) / 100;
+		GeneratePlatform(world, i);
+	}
+	ResetPlatformQueue(world);
+
+	#pragma endregion
+
+}
+
+void Sim_Step(struct GameWorld* world, const struct Sim_Input* input, float dt) {
+	world->soundEvents = 0;
+	world->gameTimer += dt;
+
+	#pragma region gameStateChecks
+
+	if (input->escKeyPressed && world->gameState == GAME_STATE_PLAYING) { // Pause Screen
+		world->gameState = GAME_STATE_PAUSE;
+	} else if (input->resumeClicked && world->gameState == GAME_STATE_PAUSE) { // Back to the Game
+		world->gameState = GAME_STATE_PLAYING;
+	} else if (world->maxY > FIRST_UPGRADE_Y_VALUE + (world->player.totalUpgrades * NEXT_UPGRADE_Y_VALUE) && (world->gameState != GAME_STATE_UPGRADE)) { // Upgrades Screen
+		world->gameState = GAME_STATE_UPGRADE;
+		world->maxY = world->player.y = 2000.0f + (world->player.totalUpgrades * 5000); // Set both maxY and playerY to upgrade constrain
+		InitializeGameStateUpgrade(&world->gameStateUpgrade,world->player.x);
+		Get3AvailableUpgrades(&world->rng[RNG_STREAM_UPGRADES], world->gameStateUpgrade.upgradeChoice, world->player.upgrades);
+	} else if (world->player.currentHealth <= 0 && world->gameState == GAME_STATE_PLAYING) { // Defeat Screen
+		world->gameState = GAME_STATE_DEFEAT;
+		InitializeGameStateDefeat(&world->gameStateDefeat);
+	}
+
+	#pragma endregion
+
+	#pragma region platformGeneration
+
+	// Formatted Y value of the player
+	// By making use of integer divion we are able to determine the players highest Y value in the 2s slightly shifted upwards (downwards on screen) by 1
+	// (1357 / 100) / 2 * 2 + 1 = 13
+	int formattedPlayerY = ((int)world->player.y / 100) / world->distanceBetweenPlatform * world->distanceBetweenPlatform + 1;
+	if (formattedPlayerY > world->lastPlayerHeightThreshold) {
+		world->lastPlayerHeightThreshold = formattedPlayerY;
+		int lookahead = world->platformCount - PLATFORM_WINDOW_ROWS; // Rows generated ahead go further down
+		int newPlatformY = ((3 + lookahead) * world->distanceBetweenPlatform + world->lastPlayerHeightThreshold);
+		ShiftPlatform(world, newPlatformY);
+		DifficultyPlatformModifier(world);
+	} else {
+		BuildQueuedPlatform(world); // Ahead of time, so the steps above only copy a row
+	}
+
+	#pragma endregion
+
+	#pragma region scoreMultiplier
+
+	if (world->player.killCount % 10 == 0) {
+		world->scoreMultipler = 1.0f + world->player.killCount / 100.0f;
+	}
+
+	#pragma endregion
+
+	if (world->gameState == GAME_STATE_PLAYING) {
+
+		#pragma region playerMovement
+
+		if (world->player.verticalVelocity < 0) {
+			// Jumping
+			if (world->player.horizontalVelocity > 0) { // Moving Right
+				world->player.animation = PLAYER_ANIMATION_JUMP_RIGHT;
+			} else if (world->player.horizontalVelocity < 0) { // Moving Left
+				world->player.animation = PLAYER_ANIMATION_JUMP_LEFT;
+			} else {
+				world->player.animation = PLAYER_ANIMATION_JUMP;
+			}
+		} else {
+			// Falling
+			if (world->player.horizontalVelocity > 0) { // Moving Right
+				world->player.animation = PLAYER_ANIMATION_FALL_RIGHT;
+			} else if (world->player.horizontalVelocity < 0) { // Moving Left
+				world->player.animation = PLAYER_ANIMATION_FALL_LEFT;
+			} else {
+				world->player.animation = PLAYER_ANIMATION_FALL;
+			}
+		}
+		// player.upgrades[3] -> Mid-Air Jumping
+		if (world->isTouching == 1 || world->player.upgrades[3]) { // If jumping, no change in horizontal velocity allowed
+			if (input->dKeyPressed && !input->aKeyPressed) { // Move Right
+				world->player.horizontalVelocity = (float)world->player.movementSpeed;
+				if (world->isTouching) {
+					world->player.animation = PLAYER_ANIMATION_RIGHT;
+				}
+			} else if (input->aKeyPressed && !input->dKeyPressed) { // Move Left
+				world->player.horizontalVelocity = -(float)world->player.movementSpeed;
+				if (world->isTouching) {
+					world->player.animation = PLAYER_ANIMATION_LEFT;
+				}
+			} else {
+				world->player.horizontalVelocity = 0;
+				if (world->isTouching) {
+					world->player.animation = PLAYER_ANIMATION_IDLE;
+				}
+			}
+		}
+
+		#pragma endregion
+
+		#pragma region collisionChecksAndUpdates
+
+		if (input->wKeyPressed && world->player.upgrades[4] && !world->doubleJumpUsed && input->wKeyTriggered && !world->isTouching) {
+			world->player.verticalVelocity = -(float)world->player.jumpSpeed; // Double JUMP! (This one cancels out pre existing gravity)
+			world->doubleJumpUsed = 1;
+			world->soundEvents |= SIM_SOUND_JUMP;
+		}
+
+		float halfWidth = world->player.width / 2.0f;
+		float halfHeight = world->player.height / 2.0f;
+		struct Physics_Box platformBoxes[MAX_PLATFORMS * MAX_PLATFORM_SEGMENTS];
+		int platformBoxCount = GetPlatformBoxes(world, world->player.x - halfWidth, world->player.y - halfHeight, world->player.x + halfWidth, world->player.y + halfHeight, platformBoxes);
+
+		// player.upgrades[5] -> Climb Up, platforms can be jumped through from below and the side
+		world->isTouching = 0; //set to touching nothing (Player is in air unless proven on the floor)
+		int insideBox = GetOverlappedBox(world->player.x, world->player.y, halfWidth, halfHeight, platformBoxes, platformBoxCount);
+		if (insideBox >= 0 && !world->fallingThroughPlatform && !world->player.upgrades[5]) {
+			// Only happens when placed inside a platform, throw player above it
+			world->player.y = platformBoxes[insideBox].top - halfHeight;
+			world->player.verticalVelocity = 0;
+			world->isTouching = 1;
+		} else if (world->player.verticalVelocity >= 0 && IsStandingOnBox(world->player.x, world->player.y, halfWidth, halfHeight, platformBoxes, platformBoxCount)) {
+			world->player.verticalVelocity = 0;
+			world->isTouching = 1; // My player's Just Standing, Chilling man
+		}
+
+		// Gravity
+		if (world->isTouching == 0 && world->gameTimer >= 1.0f) { // Falling
+			world->player.verticalVelocity += GRAVITY * dt;
+		} else if (world->player.upgrades[6] && world->player.verticalVelocity == 0 && input->sKeyPressed) { // Climb Down
+			world->fallingThroughPlatform = 1;
+			world->player.verticalVelocity += GRAVITY * dt;
+		} else {
+			world->fallingThroughPlatform = 0;
+			world->doubleJumpUsed = 0;
+		}
+
+		if (input->wKeyPressed && world->isTouching) { // Want to Jump and is on the floor
+			world->soundEvents |= SIM_SOUND_JUMP;
+			world->player.verticalVelocity -= world->player.jumpSpeed; // Jump
+		}
+
+		float horizontalFrameMovement = world->player.horizontalVelocity * dt;
+		float verticalFrameMovement = (world->player.verticalVelocity > TERMINAL_VELOCITY ? TERMINAL_VELOCITY : world->player.verticalVelocity) * dt;
+
+		if (IsCeilingCollided(world->player.y + verticalFrameMovement, world->player.height, world->maxY)) {
+			world->player.y = world->maxY - WINDOW_HEIGHT / 2.0f + world->player.height / 2.0f;
+			world->player.verticalVelocity = 0;
+			verticalFrameMovement = 0;
+		}
+
+		if (IsRightWallCollided(world->player.x + horizontalFrameMovement, world->player.width, world->wallWidth)) {
+			world->player.x = (WINDOW_WIDTH - world->wallWidth) - world->player.width / 2.0f;
+			world->player.horizontalVelocity = 0;
+			horizontalFrameMovement = 0;
+		} else if (IsLeftWallCollided(world->player.x + horizontalFrameMovement, world->player.width, world->wallWidth)) {
+			world->player.x = world->wallWidth + world->player.width / 2.0f;
+			world->player.horizontalVelocity = 0;
+			horizontalFrameMovement = 0;
+		}
+
+		// Only the platforms the player can reach during the move
+		float moveLeft = world->player.x + (horizontalFrameMovement < 0 ? horizontalFrameMovement : 0) - halfWidth;
+		float moveRight = world->player.x + (horizontalFrameMovement > 0 ? horizontalFrameMovement : 0) + halfWidth;
+		float moveTop = world->player.y + (verticalFrameMovement < 0 ? verticalFrameMovement : 0) - halfHeight;
+		float moveBottom = world->player.y + (verticalFrameMovement > 0 ? verticalFrameMovement : 0) + halfHeight;
+		platformBoxCount = GetPlatformBoxes(world, moveLeft, moveTop, moveRight, moveBottom, platformBoxes);
+
+		// Climbing down drops through the platforms the player is standing on (or already in)
+		if (world->fallingThroughPlatform) {
+			int kept = 0;
+			for (int i = 0; i < platformBoxCount; ++i) {
+				if (platformBoxes[i].top - halfHeight > world->player.y) {
+					platformBoxes[kept++] = platformBoxes[i];
+				}
+			}
+			platformBoxCount = kept;
+		}
+
+		// Moves the player up to the first platform in the way, then slides the rest of the move along it
+		for (int i = 0; i < PHYSICS_MAX_SLIDES && (horizontalFrameMovement != 0 || verticalFrameMovement != 0); ++i) {
+			struct Physics_Contact contact = SweepBox(world->player.x, world->player.y, halfWidth, halfHeight, horizontalFrameMovement, verticalFrameMovement, platformBoxes, platformBoxCount, world->player.upgrades[5]);
+			if (contact.box < 0) {
+				world->player.x += horizontalFrameMovement;
+				world->player.y += verticalFrameMovement;
+				break;
+			}
+
+			const struct Physics_Box* box = &platformBoxes[contact.box];
+			if (contact.normalX != 0) { // Slammed face first into the side of a platform
+				world->player.x = contact.normalX < 0 ? box->left - halfWidth : box->right + halfWidth;
+				world->player.y += verticalFrameMovement * contact.time;
+				world->player.horizontalVelocity = 0;
+				horizontalFrameMovement = 0;
+				verticalFrameMovement *= 1 - contact.time;
+			} else { // Landed on top of a platform, or hit the head on the bottom of one
+				world->player.x += horizontalFrameMovement * contact.time;
+				world->player.y = contact.normalY < 0 ? box->top - halfHeight : box->bottom + halfHeight;
+				world->player.verticalVelocity = 0;
+				world->isTouching = contact.normalY < 0;
+				verticalFrameMovement = 0;
+				horizontalFrameMovement *= 1 - contact.time;
+			}
+		}
+		world->maxY = world->maxY < world->player.y ? world->player.y : world->maxY; // Check if current player y value is larger than highest y value the player last went
+		// IMPORTANT!!! After this point, NO MORE UPDATING OF PLAYER X / Y VALUE
+
+		#pragma endregion	
+
+		#pragma region pickups
+
+		if (CheckPlayerPickedUpHealth(world)) {
+			world->player.currentHealth += 1; // Heal 1 Health/Pickup
+			world->soundEvents |= SIM_SOUND_PICKUP;
+		}
+
+		DespawnHealthPickup(world);
+
+		#pragma endregion
+
+		#pragma region hazards
+
+		world->damageTaken[DAMAGE_SOURCE_LAZER] += FireExpiredLazers(world);
+
+		#pragma endregion
+
+		#pragma region bullets
+
+		// Handle Bullet Firing
+		if (input->leftMouseHold) {
+			if (1.0f / (float)world->player.fireRate < world->gameTimer - world->lastShotTimer) {
+				FireBullet(world, input->mouseX, input->mouseY);
+				world->lastShotTimer = world->gameTimer;
+			}
+		}
+
+		// Bullet Platform Collision
+		if (!world->player.upgrades[7]) {
+			BulletHitPlatform(world);
+		}
+
+		// Moves / Update Bullets
+		UpdateBullets(world, dt);
+		BulletHitWalkingEnemy(world);
+		BulletHitFlyingEnemy(world); // Bullet Hitting & Damaging Enemy
+
+		#pragma endregion
+
+		#pragma region enemySpawning
+
+		DifficultyModifier(world);
+
+		//Walking Enemy Logic
+		DespawnWalkingEnemy(world);
+		WalkingEnemyLogic(world, dt);
+		int walkingHits = WalkingEnemyTouchPlayer(world);
+		if (walkingHits) {
+			world->soundEvents |= SIM_SOUND_DAMAGED;
+			world->damageTaken[DAMAGE_SOURCE_WALKING] += walkingHits;
+		}
+
+		//Flying Enemy Logic
+		DespawnFlyingEnemy(world);
+		UpdateFlyingEnemies(world, dt); // Handles the moving of flying enemies
+		int flyingHits = FlyingEnemyTouchPlayer(world); // Handles the collision and damage of the player
+		if (flyingHits) {
+			world->soundEvents |= SIM_SOUND_DAMAGED;
+			world->damageTaken[DAMAGE_SOURCE_FLYING] += flyingHits;
+		}
+
+		#pragma endregion
+
+	} else if (world->gameState == GAME_STATE_UPGRADE) {
+
+		#pragma region gameStateUpgrades
+
+		world->player.horizontalVelocity = 0; // To make player always fall to the center
+		// Upgrade Game State goes like this
+		// Right after Y:2000 -> Animation before Upgrade choice -> Upgrade Choice -> Animation after Upgrade Choice -> Continue Game
+		float timeBeforeUpgrade = 1.5f;
+		float timeBeforeEndState = 1.5f;
+
+		if (!world->gameStateUpgrade.isUpgradeChosen) { // PART 1: When the Player hasn't chosen Upgrade
+			world->gameStateUpgrade.secondsSinceState += dt;
+			world->gameStateUpgrade.chosenUpgrade = GetUpgradeSelected(world->maxY, input->mouseX, input->mouseY);
+
+			if (world->gameStateUpgrade.chosenUpgrade && input->leftMouseClick && (world->gameStateUpgrade.secondsSinceState / timeBeforeUpgrade > 1)) { // Player Clicked Upgrade
+				world->player.upgrades[world->gameStateUpgrade.upgradeChoice[world->gameStateUpgrade.chosenUpgrade - 1]]++;
+				if (world->gameStateUpgrade.upgradeChoice[world->gameStateUpgrade.chosenUpgrade - 1] == 0) {
+					world->player.maxHealth++;
+					world->player.currentHealth++;
+				} else if (world->gameStateUpgrade.upgradeChoice[world->gameStateUpgrade.chosenUpgrade - 1] == 1) {
+					world->player.damage += UPGRADE_DAMAGE_INCREMENT;
+				} else if (world->gameStateUpgrade.upgradeChoice[world->gameStateUpgrade.chosenUpgrade - 1] == 2) {
+					world->player.movementSpeed += UPGRADE_SPEED_INCREMENT;
+				} else if (world->gameStateUpgrade.upgradeChoice[world->gameStateUpgrade.chosenUpgrade - 1] == 8) {
+					world->player.fireRate += UPGRADE_FIRERATE_INCREMENT;
+				} else if (world->gameStateUpgrade.upgradeChoice[world->gameStateUpgrade.chosenUpgrade - 1] == 9) {
+					world->player.projectileSize += UPGRADE_PROJECTILESIZE_INCREMENT;
+				} else if (world->gameStateUpgrade.upgradeChoice[world->gameStateUpgrade.chosenUpgrade - 1] == 10) {
+					world->player.projectileSpeed += UPGRADE_PROJECTILESPEED_INCREMENT;
+				}
+				world->player.totalUpgrades++;
+				world->player.verticalVelocity = 0;
+				world->gameStateUpgrade.isUpgradeChosen = 1;
+				InitializeLazerHazard(world->lazerHazards, &world->lazerHazardPool);
+				InitializeFlyingEnemies(world->flyingEnemies, &world->flyingEnemyPool);
+				InitializeWalkingEnemies(&world->walkingEnemies);
+				InitializeBullets(world->bullets, &world->bulletPool);
+			}
+		}
+		// NOTE: I know it looks like it should be a "else". 
+		// But for that specific frame that upgrade is clicked, both if statements need to go through
+		if (world->gameStateUpgrade.isUpgradeChosen) { // PART 2: After the Player chosen upgrade
+			world->gameStateUpgrade.secondsSinceUpgradeChosen += dt;
+
+			if (world->gameStateUpgrade.secondsSinceUpgradeChosen > timeBeforeEndState) { // Animations are done, Next Phase
+				world->gameState = GAME_STATE_PLAYING;
+			}
+		} else { // Player falls to the center while the upgrades are shown
+			float animationTimer = world->gameStateUpgrade.secondsSinceState / timeBeforeUpgrade > 1 ? 1 : world->gameStateUpgrade.secondsSinceState / timeBeforeUpgrade;
+			world->player.x = WINDOW_WIDTH / 2.0f + world->gameStateUpgrade.distanceToCenter * (1 - animationTimer);
+			world->maxY = world->player.y = FIRST_UPGRADE_Y_VALUE + NEXT_UPGRADE_Y_VALUE * world->player.totalUpgrades + FALLING_Y_VALUE / 2.0f * (animationTimer);
+		}
+
+		#pragma endregion
+
+	} else if (world->gameState == GAME_STATE_DEFEAT) {
+		world->gameStateDefeat.secondsSinceState += dt;
+	}
+}
+
+int Sim_Advance(struct GameWorld* world, struct Sim_Input* input, float frameTime, float* accumulator, struct Replay* replay) {
+	float dt = 1.0f / SIM_STEPS_PER_SECOND;
+	int steps = 0;
+	int soundEvents = 0;
+
+	*accumulator += frameTime;
+	while (*accumulator >= dt && steps < SIM_MAX_STEPS_PER_FRAME) {
+		if (replay != NULL && replay->isPlaying) {
+			struct Sim_Input replayInput;
+			if (Replay_ReadStep(replay, &replayInput)) {
+				*input = replayInput;
+			}
+		} else if (replay != NULL) {
+			Replay_RecordStep(replay, world, input);
+		}
+
+		Sim_Step(world, input, dt);
+		if (replay != NULL && !replay->isPlaying) {
+			Replay_RecordHash(replay, world);
+		}
+		soundEvents |= world->soundEvents; // Keep sounds raised by earlier steps
+		*accumulator -= dt;
+		steps++;
+
+		// Presses only happen once, holds carry on through every step
+		input->wKeyTriggered = 0;
+		input->escKeyPressed = 0;
+		input->leftMouseClick = 0;
+		input->resumeClicked = 0;
+	}
+	if (steps == SIM_MAX_STEPS_PER_FRAME && *accumulator >= dt) { // Too far behind, drop the rest
+		*accumulator = 0;
+	}
+	world->soundEvents = soundEvents;
+
+	return steps;
+}
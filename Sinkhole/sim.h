@@ -0,0 +1,65 @@
+#pragma once
+//------------------------------------------------------------------------------------
+// file: sim.h
+//
+// authors:
+// l.zheneudamon (primary author)
+//		Added Sim_Init and Sim_Step
+//		Seeded runs, the same seed and inputs play out the same
+//		Sim_Advance records or plays back replays
+//
+// brief:
+// Contains the declaration of functions in sim.c.
+// The simulation does not depend on CProcessing, it can be stepped
+// without a window (see headless.c).
+//
+// documentation link:
+// https://github.com/gwong-dp/c_processing/wiki
+//
+// All Content © 2023 DigiPen Institute of Technology Singapore, All rights reserved.
+//------------------------------------------------------------------------------------
+
+struct Replay; // Defined in replay.h
+
+enum {
+	// Sound Events (Raised by Sim_Step, played by the front end)
+	SIM_SOUND_JUMP = 1,
+	SIM_SOUND_DAMAGED = 2,
+	SIM_SOUND_PICKUP = 4,
+
+	// Fixed Time Step
+	SIM_STEPS_PER_SECOND = 60, // Every Sim_Step is 1 / SIM_STEPS_PER_SECOND seconds long
+	SIM_MAX_STEPS_PER_FRAME = 8, // Longer hitches than this are dropped instead of caught up on
+};
+
+/// <summary>
+/// Resets the world to the start of a new run.
+/// Every random roll of the run comes from the seed.
+/// </summary>
+/// <param name="world">Address of Game World</param>
+/// <param name="seed">Seed of the run</param>
+void Sim_Init(struct GameWorld* world, unsigned long long seed);
+
+/// <summary>
+/// Advances the world by one step. Does not draw or play anything.
+/// </summary>
+/// <param name="world">Address of Game World</param>
+/// <param name="input">Input for this step</param>
+/// <param name="dt">Time Step in Seconds</param>
+void Sim_Step(struct GameWorld* world, const struct Sim_Input* input, float dt);
+
+/// <summary>
+/// Advances the world by as many fixed steps as fit in the time that has passed.
+/// Leftover time is kept in the accumulator for the next frame. Triggered inputs
+/// (key and mouse presses) are cleared once a step has seen them, so a press is
+/// never applied twice and never lost on a frame without steps.
+/// With a replay, the input (and world hash) of every step is recorded, or while the replay
+/// is playing, read from it instead (the live input takes over once it ends).
+/// </summary>
+/// <param name="world">Address of Game World</param>
+/// <param name="input">Address of Input, triggered inputs are cleared once used</param>
+/// <param name="frameTime">Time since the last call in Seconds</param>
+/// <param name="accumulator">Address of the time not simulated yet in Seconds</param>
+/// <param name="replay">Address of Replay to record to or play from, NULL for none</param>
+/// <returns>Number of steps taken</returns>
+int Sim_Advance(struct GameWorld* world, struct Sim_Input* input, float frameTime, float* accumulator, struct Replay* replay);
@@ -4,6 +4,10 @@
 // authors:
 // timo.duethorn (primary author)
 //		Added Content of Splash Screen (Fading Logo & Text)
+// l.zheneudamon
+//		Changed the font to come from the Asset Registry
+//		Changed images to come from the Asset Registry, evicted on exit
+//		Added loading of the game's assets while the splash screen plays, with a progress bar
 //
 // brief:
 // Contains the code to load and render the Splash Screen, then auto navigate to the Main Menu.
@@ -15,6 +19,9 @@
 //------------------------------------------------------------------------------------
 
 #include "cprocessing.h"
+#include "initialize.h"
+#include "assets.h"
+#include "loader.h"
 #include "mainmenu.h"
 
 CP_Image digipenLogo, blackCover;
@@ -28,9 +35,10 @@ float sigmaAlpha = 255.0f;
 float windowWidth, windowHeight;
 
 void Splash_Screen_Init(void) {
-	digipenLogo = CP_Image_Load("Assets/Images/DigiPen/DigiPen_Singapore_WEB_WHITE.png");
-	blackCover = CP_Image_Load("Assets/Images/Background/black.png");
-	sigmaFont = CP_Font_Load("Assets/Fonts/RussoOne-Regular.ttf");
+	digipenLogo = Assets_LoadImage("Assets/Images/DigiPen/DigiPen_Singapore_WEB_WHITE.png");
+	blackCover = Assets_LoadImage("Assets/Images/Background/black.png");
+	sigmaFont = Assets_GetFont(Assets_LoadFont("Assets/Fonts/RussoOne-Regular.ttf"));
+	Loader_Start(LOADER_MANIFEST); // The rest of the game's assets, while the logo fades
 	black = CP_Color_Create(0, 0, 0, 255);
 	white = CP_Color_Create(255, 255, 255, 255);
 
@@ -57,12 +65,24 @@ void Splash_Screen_Update(void) {
 		CP_Image_Draw(blackCover, windowWidth / 2.0f, windowHeight / 2.0f, windowWidth, windowHeight, (int)sigmaAlpha);
 	}
 
+	// Loading Progress Bar
+	Loader_Update();
+	if (Loader_GetProgress() < 1.0f) {
+		CP_Settings_Save(); // Leaves the text settings as they were
+		CP_Settings_NoStroke();
+		CP_Settings_RectMode(CP_POSITION_CORNER);
+		CP_Settings_Fill(CP_Color_Create(255, 255, 255, 64));
+		CP_Graphics_DrawRect(0, windowHeight - 6.0f, windowWidth * Loader_GetProgress(), 6.0f);
+		CP_Settings_Restore();
+	}
+
 	if (counter > 8.0f || CP_Input_KeyTriggered(KEY_ESCAPE)) { // ESC Key Shortcut
 		CP_Engine_SetNextGameState(Main_Menu_Init, Main_Menu_Update, Main_Menu_Exit);
 	}
 }
 
 void Splash_Screen_Exit(void) {
-	CP_Image_Free(&digipenLogo);
-	CP_Image_Free(&blackCover);
+	Assets_ReleaseImage(&digipenLogo);
+	Assets_ReleaseImage(&blackCover);
+	Assets_Evict(); // The splash screen is never shown again, the loader keeps the rest of the assets
 }
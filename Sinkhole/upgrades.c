@@ -15,11 +15,10 @@
 //------------------------------------------------------------------------------------
 
 #include <math.h>
-#include "cprocessing.h"
 #include "initialize.h"
 #include "utils.h"
 
-void Get3AvailableUpgrades(int chosenUpgrades[], int playerUpgrades[]) {
+void Get3AvailableUpgrades(struct Rng* rng, int chosenUpgrades[], int playerUpgrades[]) {
 	// Create an Array to hold available options to RNG from
 	// Since upgrades 1-3 are always available, they are here first
 	int availableUpgrades[MAX_UPGRADES] = { 1,2,3 };
@@ -58,7 +57,7 @@ void Get3AvailableUpgrades(int chosenUpgrades[], int playerUpgrades[]) {
 	int chosenUpgrade2 = 0;
 	int chosenUpgrade3 = 0;
 	while (count < 3) {
-		int randInt = RandomNumber(0, maxElements-1);
+		int randInt = RandomNumber(rng, 0, maxElements-1);
 		rngedUpgrade = availableUpgrades[randInt];
 		if (chosenUpgrade1) {
 			if (chosenUpgrade1 != rngedUpgrade) {
@@ -82,19 +81,18 @@ void Get3AvailableUpgrades(int chosenUpgrades[], int playerUpgrades[]) {
 	chosenUpgrades[2] = chosenUpgrade3 - 1; 
 }
 
-int GetUpgradeSelected(float maxY) {
-	float upgrade1X = CP_System_GetWindowWidth() * 0.25f;
-	float upgrade2X = CP_System_GetWindowWidth() * 0.50f;
-	float upgrade3X = CP_System_GetWindowWidth() * 0.75f;
-	float width = CP_System_GetWindowWidth() * 0.2f;
-	float height = CP_System_GetWindowHeight() * 0.8f;
+int GetUpgradeSelected(float maxY, float mouseX, float mouseY) {
+	float upgrade1X = WINDOW_WIDTH * 0.25f;
+	float upgrade2X = WINDOW_WIDTH * 0.50f;
+	float upgrade3X = WINDOW_WIDTH * 0.75f;
+	float width = WINDOW_WIDTH * 0.2f;
+	float height = WINDOW_HEIGHT * 0.8f;
 
-	float screenShift = maxY - CP_System_GetWindowHeight() / 2.0f;
-	if (IsAreaClicked(upgrade1X, maxY, width, height, CP_Input_GetMouseX(), CP_Input_GetMouseY() + screenShift)) {
+	if (IsAreaClicked(upgrade1X, maxY, width, height, mouseX, mouseY)) {
 		return 1;
-	} else if (IsAreaClicked(upgrade2X, maxY, width, height, CP_Input_GetMouseX(), CP_Input_GetMouseY() + screenShift)) {
+	} else if (IsAreaClicked(upgrade2X, maxY, width, height, mouseX, mouseY)) {
 		return 2;
-	} else if (IsAreaClicked(upgrade3X, maxY, width, height, CP_Input_GetMouseX(), CP_Input_GetMouseY() + screenShift)) {
+	} else if (IsAreaClicked(upgrade3X, maxY, width, height, mouseX, mouseY)) {
 		return 3;
 	} else{
 		return 0;
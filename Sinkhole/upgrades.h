@@ -18,13 +18,16 @@
 /// <summary>
 /// Updates an Array with random available upgrades.
 /// </summary>
+/// <param name="rng">Address of the Random Number Stream to draw from</param>
 /// <param name="chosenUpgrades">Array of size 3. This will contain the output</param>
 /// <param name="playerUpgrades">Array of upgrades that the player already has</param>
-void Get3AvailableUpgrades(int chosenUpgrades[], int playerUpgrades[]);
+void Get3AvailableUpgrades(struct Rng* rng, int chosenUpgrades[], int playerUpgrades[]);
 
 /// <summary>
 /// Detects which upgrade is being selected.
 /// </summary>
 /// <param name="maxY">Middle of screen Y value</param>
+/// <param name="mouseX">Mouse World X Value</param>
+/// <param name="mouseY">Mouse World Y Value</param>
 /// <returns>Integer of 1,2,3 for upgrades, or 0 if none selected</returns>
-int GetUpgradeSelected(float maxY);
+int GetUpgradeSelected(float maxY, float mouseX, float mouseY);
@@ -5,9 +5,10 @@
 // l.zheneudamon (primary author)
 //		Added Rectangles intersecting 
 //		Added Circles and Rectangles intersecting
-//		Added CutString and Text Wrap functions
-//		Added Animation Loader and unloader
-//		Added Animator (Get animation image address)
+//		Added CutString function
+//		Replaced rand() with a seeded xoshiro256** per stream
+//		Added Circles and Edges intersecting
+//		Added counter based Random Number Streams
 // timo.duethorn
 //		Added Random Number Generator
 //		Added is Area Clicked / is Circle Clicked
@@ -26,8 +27,8 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h> 
-#include "cprocessing.h"
 #include "initialize.h"
+#include "utils.h"
 
 int IsAreaClicked(float area_center_x, float area_center_y, float area_width, float area_height, float click_x, float click_y) {
 	if (click_x > (area_center_x - (area_width / 2.0f)) && click_x < (area_center_x + (area_width / 2.0f)) && (click_y > area_center_y - (area_height / 2.0f)) && (click_y < area_center_y + (area_height / 2.0f))) {
@@ -82,11 +83,10 @@ int AreRectanglesIntersecting(float r1_x, float r1_y, float r1_width, float r1_h
 }
 
 int IsCircleAndRectIntersecting(float circle_x, float circle_y, float circle_diameter, float rect_x, float rect_y, float rect_width, float rect_height) {
-	float leftRect = rect_x - rect_width / 2.0f;
-	float rightRect = rect_x + rect_width / 2.0f;
-	float topRect = rect_y - rect_height / 2.0f;
-	float bottomRect = rect_y + rect_height / 2.0f;
+	return IsCircleAndEdgesIntersecting(circle_x, circle_y, circle_diameter, rect_x - rect_width / 2.0f, rect_y - rect_height / 2.0f, rect_x + rect_width / 2.0f, rect_y + rect_height / 2.0f);
+}
 
+int IsCircleAndEdgesIntersecting(float circle_x, float circle_y, float circle_diameter, float leftRect, float topRect, float rightRect, float bottomRect) {
 	float leftCircle = circle_x - circle_diameter / 2.0f; // Left Most X value of circle
 	float rightCircle = circle_x + circle_diameter / 2.0f; // Right Most X value of circle
 	float topCircle = circle_y - circle_diameter / 2.0f; // Top Most X value of circle
@@ -127,70 +127,82 @@ int IsCircleAndRectIntersecting(float circle_x, float circle_y, float circle_dia
 }
 
 // Random number function that returns a value within a range specified by the input parameters
-int RandomNumber(int min, int max) {
-	int value = min + rand() % (max - min + 1);
-	return value;
+#pragma region randomNumbers
+
+// xoshiro256** by David Blackman and Sebastiano Vigna (public domain)
+unsigned long long RotateLeft(unsigned long long x, int k) {
+	return (x << k) | (x >> (64 - k));
 }
 
-void CutString(char string[], int size, int cut) {
-	for (int i = 0; i < size-cut; i++) {
-		string[i] = string[i + cut];
-		string[i + cut] = '\0'; // Emptying String
-	}
+unsigned long long NextRandom(struct Rng* rng) {
+	unsigned long long* s = rng->state;
+	unsigned long long result = RotateLeft(s[1] * 5, 7) * 9;
+	unsigned long long t = s[1] << 17;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = RotateLeft(s[3], 45);
+	return result;
 }
 
-void DrawTextWithWrap(char text[], float x, float y, int charactersPerLine, float gapBetweenEachLine) {
-	char textString[MAX_UPGRADE_TEXT] = { 0 };
-	sprintf_s(textString, MAX_UPGRADE_TEXT, "%s", text);
-	int lastWordPosition = 0, currentLine = 0;
-	for (int i = 0; i < MAX_UPGRADE_TEXT; i++) {
-		if (textString[i] == ' ') {
-			lastWordPosition = i;
-		}
+void SeedRandom(struct Rng* rng, unsigned long long seed, int stream) {
+	// Fill the state with splitmix64 so that any seed (even 0) gives a good state
+	for (int i = 0; i < 4; ++i) {
+		seed += 0x9E3779B97F4A7C15ULL;
+		unsigned long long z = seed;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		rng->state[i] = z ^ (z >> 31);
+	}
 
-		if (i && i % charactersPerLine == 0) {
-			textString[lastWordPosition] = '\0';
-			CP_Font_DrawText(textString, x, y + currentLine * gapBetweenEachLine);
-			CutString(textString, MAX_UPGRADE_TEXT, lastWordPosition + 1);
-			i = -1, currentLine++;
-			continue;
+	// Each stream jumps 2^128 draws ahead of the one before it, so streams never overlap
+	static const unsigned long long jump[4] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+	for (int n = 0; n < stream; ++n) {
+		unsigned long long jumped[4] = { 0 };
+		for (int i = 0; i < 4; ++i) {
+			for (int b = 0; b < 64; ++b) {
+				if (jump[i] & (1ULL << b)) {
+					for (int j = 0; j < 4; ++j) {
+						jumped[j] ^= rng->state[j];
+					}
+				}
+				NextRandom(rng);
+			}
 		}
-
-		if (textString[i] == '\0') {
-			break;
+		for (int j = 0; j < 4; ++j) {
+			rng->state[j] = jumped[j];
 		}
 	}
-	CP_Font_DrawText(textString, x, y + currentLine * gapBetweenEachLine);
 }
 
-void AnimationImageLoader(CP_Image imageArray[], char fileName[], int numberOfFrames) {
-	for (int i = 0; i < numberOfFrames; ++i) {
-		char filePath[MAX_ASSET_FILEPATH] = "Assets/Images/";
-		strcat_s(filePath, MAX_ASSET_FILEPATH, fileName);
-		char frameNumber[MAX_FRAME_DIGITS] = {0};
-		snprintf(frameNumber, MAX_FRAME_DIGITS, "%d", i);
-		strcat_s(filePath, MAX_ASSET_FILEPATH, frameNumber);
-		strcat_s(filePath, MAX_ASSET_FILEPATH, ".png");
-		imageArray[i] = CP_Image_Load(filePath);
-	}
+void SeedRandomAt(struct Rng* rng, unsigned long long seed, int stream, int counter) {
+	// splitmix64 of the stream and counter, so neighbouring counters give unrelated seeds
+	unsigned long long z = (((unsigned long long)(unsigned int)stream << 32) | (unsigned int)counter) + 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	SeedRandom(rng, seed ^ (z ^ (z >> 31)), 0);
 }
 
-void ImageUnloader(CP_Image imageArray[], int numberOfImage) {
-	for (int i = 0; i < numberOfImage; ++i){
-		CP_Image_Free(&imageArray[i]);
+int RandomNumber(struct Rng* rng, int min, int max) {
+	// Lemire's multiply and reject, unlike rand() % n every value is equally likely
+	unsigned int range = (unsigned int)(max - min) + 1;
+	unsigned long long m = (NextRandom(rng) >> 32) * range;
+	if ((unsigned int)m < range) {
+		unsigned int threshold = (0u - range) % range;
+		while ((unsigned int)m < threshold) {
+			m = (NextRandom(rng) >> 32) * range;
+		}
 	}
+	return min + (int)(m >> 32);
 }
 
-CP_Image* GetAnimationImageAddress(CP_Image arrayImages[], int MAX_FRAME_IN_ANIMATION, float gameTimer) {
-	CP_Image *returningImage = NULL;
-	int animationFrame = (int)(gameTimer * MAX_FRAME_IN_ANIMATION) % MAX_FRAME_IN_ANIMATION;
-	for (int i = MAX_FRAME_IN_ANIMATION - 1; i >= 0; --i) { // Animate through each frame of the player
-		if (animationFrame == i) {
-			returningImage = &arrayImages[i];
-			break;
-		} else {
-			returningImage = &arrayImages[0];
-		}
+#pragma endregion
+
+void CutString(char string[], int size, int cut) {
+	for (int i = 0; i < size-cut; i++) {
+		string[i] = string[i + cut];
+		string[i + cut] = '\0'; // Emptying String
 	}
-	return returningImage;
 }
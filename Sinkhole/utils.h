@@ -6,9 +6,11 @@
 // l.zheneudamon (primary author)
 //		Added Rectangles intersecting 
 //		Added Circles and Rectangles intersecting
-//		Added CutString and Text Wrap functions
-//		Added Animation Loader and unloader
-//		Added Animator (Get animation image address)
+//		Added CutString function
+//		Added seeded Random Number Streams
+//		Added Circles and Edges intersecting
+//		Added cache aligned allocations
+//		Added counter based Random Number Streams
 // timo.duethorn
 //		Added Random Number Generator
 //		Added is Area Clicked / is Circle Clicked
@@ -71,6 +73,19 @@ int AreCirclesIntersecting(float c1_x, float c1_y, float r1, float c2_x, float c
 /// <returns>1 if circle and rect are intersecting, else 0</returns>
 int IsCircleAndRectIntersecting(float circle_x, float circle_y, float circle_diameter, float rect_x, float rect_y, float rect_width, float rect_height);
 
+/// <summary>
+/// Checks if a Circle and a Rectangle given by its edges are Intersecting.
+/// </summary>
+/// <param name="circle_x">circle x value</param>
+/// <param name="circle_y">circle y value</param>
+/// <param name="circle_diameter">circle diameter value</param>
+/// <param name="rect_left">rectangle left edge</param>
+/// <param name="rect_top">rectangle top edge</param>
+/// <param name="rect_right">rectangle right edge</param>
+/// <param name="rect_bottom">rectangle bottom edge</param>
+/// <returns>1 if circle and rect are intersecting, else 0</returns>
+int IsCircleAndEdgesIntersecting(float circle_x, float circle_y, float circle_diameter, float rect_left, float rect_top, float rect_right, float rect_bottom);
+
 /// <summary>
 /// Checks if two Rectangles are Intersecting.
 /// </summary>
@@ -85,13 +100,34 @@ int IsCircleAndRectIntersecting(float circle_x, float circle_y, float circle_dia
 /// <returns>1 if rects are intersecting, else 0</returns>
 int AreRectanglesIntersecting(float r1_x, float r1_y, float r1_width, float r1_height, float r2_x, float r2_y, float r2_width, float r2_height);
 
+struct Rng; // Defined in initialize.h
+
+/// <summary>
+/// Seeds a random number stream. Streams from the same seed never overlap.
+/// </summary>
+/// <param name="rng"> Address of the Random Number Stream </param>
+/// <param name="seed"> Seed of the run </param>
+/// <param name="stream"> RNG_STREAM_* </param>
+void SeedRandom(struct Rng* rng, unsigned long long seed, int stream);
+
+/// <summary>
+/// Seeds a random number stream for one counter value (like the y of a row of platforms).
+/// The draws only depend on the seed, stream and counter, so counters can be used in any order.
+/// </summary>
+/// <param name="rng"> Address of the Random Number Stream </param>
+/// <param name="seed"> Seed of the run </param>
+/// <param name="stream"> RNG_STREAM_* </param>
+/// <param name="counter"> Counter value </param>
+void SeedRandomAt(struct Rng* rng, unsigned long long seed, int stream, int counter);
+
 /// <summary>
 /// Generates a random number within a specified range.
 /// </summary>
+/// <param name="rng"> Address of the Random Number Stream to draw from </param>
 /// <param name="min"> Min value of the randomly generated number </param>
 /// <param name="max"> Max value of the randomly generated number </param>
 /// <returns> Returns the randomly generated number </returns>
-int RandomNumber(int min, int max);
+int RandomNumber(struct Rng* rng, int min, int max);
 
 /// <summary>
 /// Deletes characters from the string starting from the front.
@@ -100,38 +136,3 @@ int RandomNumber(int min, int max);
 /// <param name="size"> The max size of the string </param>
 /// <param name="cut"> The amount of elements to remove </param>
 void CutString(char string[], int size, int cut);
-
-/// <summary>
-/// Draws Text on the screen with wrapping based on max characters.
-/// This function assumes that text is already predefined.
-/// </summary>
-/// <param name="text"> String to print on screen </param>
-/// <param name="x"> X value to draw </param>
-/// <param name="y"> Y value of first line to draw </param>
-/// <param name="charactersPerLine"> Max number of characters in a line </param>
-/// <param name="gapBetweenEachLine"> Space between each line </param>
-void DrawTextWithWrap(char text[], float x, float y, int charactersPerLine, float gapBetweenEachLine);
-
-/// <summary>
-/// Loads Images using CP_Image_Load.
-/// </summary>
-/// <param name="imageArray"> Array holding the Images </param>
-/// <param name="fileName"> Relative file name of the Images. "Player/player_idle_" </param>
-/// <param name="numberOfFrames"> Number of frames the Image has </param>
-void AnimationImageLoader(CP_Image imageArray[], char fileName[], int numberOfFrames);
-
-/// <summary>
-/// Frees Images using CP_Image_Free.
-/// </summary>
-/// <param name="imageArray"> Array holding the Images </param>
-/// <param name="numberOfImage"> Number of Images </param>
-void ImageUnloader(CP_Image imageArray[], int numberOfImage);
-
-/// <summary>
-/// Selects the correct frame in animation using game Timer.
-/// </summary>
-/// <param name="arrayImages"> Array holding the Images </param>
-/// <param name="MAX_FRAME_IN_ANIMATION"> ENUM of max number of frames/images </param>
-/// <param name="gameTimer"> Timer that increases per frame </param>
-/// <returns> Address of frame Image </returns>
-CP_Image* GetAnimationImageAddress(CP_Image arrayImages[], int MAX_FRAME_IN_ANIMATION, float gameTimer);